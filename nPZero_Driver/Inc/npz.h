@@ -29,6 +29,33 @@ typedef enum
     INVALID_PARAM = 0x02, /**< Invalid Parameter. */
 } npz_status_e;
 
+/** Cause of the last driver failure, see npz_error_s. */
+typedef enum
+{
+    NPZ_ERROR_NONE = 0x00,              /**< No failure recorded. */
+    NPZ_ERROR_NULL_CONFIG = 0x01,       /**< A required configuration or sequence pointer is NULL. */
+    NPZ_ERROR_INVALID_PARAM = 0x02,     /**< A configuration value is out of range for its register. */
+    NPZ_ERROR_NOT_IN_BUILD = 0x03,      /**< Peripheral, protocol or polling mode left out by npz_config.h. */
+    NPZ_ERROR_SRAM_FULL = 0x04,         /**< The init sequences do not fit in the device SRAM. */
+    NPZ_ERROR_REGISTER_WRITE = 0x05,    /**< Writing a register over I2C failed. */
+    NPZ_ERROR_REGISTER_READ = 0x06,     /**< Reading a register over I2C failed. */
+    NPZ_ERROR_ADC_NOT_CONNECTED = 0x07, /**< The external ADC reads the code of a floating ADC_IN pin. */
+} npz_error_cause_e;
+
+/** Register value of npz_error_s when the failure is not tied to a register. */
+#define NPZ_ERROR_NO_REGISTER 0xFF
+
+/** Peripheral value of npz_error_s when the failure is not tied to a peripheral. */
+#define NPZ_ERROR_NO_PERIPHERAL (-1)
+
+/** Details of the last driver failure. */
+typedef struct
+{
+    npz_error_cause_e cause; /**< What went wrong. */
+    uint8_t reg;             /**< Register (or SRAM) address involved, NPZ_ERROR_NO_REGISTER if none. */
+    int8_t peripheral;       /**< Zero-based peripheral index, NPZ_ERROR_NO_PERIPHERAL if none. */
+} npz_error_s;
+
 /** Reset Reason, see npz_register_sta1_s. */
 typedef enum
 {
@@ -539,6 +566,15 @@ typedef struct
 	npz_register_sta2_s status2;
 } npz_status_s;
 
+/** Register writes recorded by npz_capture_begin(), in the order they were issued. */
+typedef struct
+{
+    uint16_t count;                        /**< Number of recorded writes. */
+    bool overflow;                         /**< Set when more than NPZ_IMAGE_MAX_WRITES writes were issued. */
+    uint8_t reg[NPZ_IMAGE_MAX_WRITES];     /**< Register (or SRAM) address of each write. */
+    uint8_t value[NPZ_IMAGE_MAX_WRITES];   /**< Value of each write. */
+} npz_image_s;
+
 /** User configuration (Global parameters). */
 
 /** Struct that holds configuration for ADC channels. */
@@ -590,14 +626,17 @@ typedef struct
             uint8_t num_of_retries_on_nak : 2; /**< Number of I2C peripheral communication retries in case of NAK.
                                                 * A value of 0 means no retries, the polling is aborted immediately
                                                 * when a NAK is received (TCFGP). */
-            uint8_t bytes_from_sram[40]; /**< bytes to send from the SRAM (NCMDP). */ /*TODO Test*/
+            const uint8_t *bytes_from_sram; /**< Address/value pairs to send from the SRAM (NCMDP), command_num * 2
+                                             * bytes long. May point to flash. */
         } i2c_cfg;
         struct
         {
             uint8_t bytes_from_sram_num;          /**< The number of bytes to send from the SRAM for initialization (NCMDP). */
             uint8_t bytes_from_sram_read_num; /**< The number of bytes to send from SRAM for value read (ADDRP). */
-            uint8_t bytes_from_sram[40];          /**< The bytes to send from SRAM for initialization. */ /*TODO Test*/
-            uint8_t bytes_from_sram_read[40];     /**< The bytes to send from SRAM for value read. */ /*TODO Test*/
+            const uint8_t *bytes_from_sram;       /**< The bytes to send from SRAM for initialization,
+                                                   * bytes_from_sram_num bytes long. May point to flash. */
+            const uint8_t *bytes_from_sram_read;  /**< The bytes to send from SRAM for value read,
+                                                   * bytes_from_sram_read_num bytes long. May point to flash. */
             npz_spimod_e mode;                    /**< Sets the SPI mode if SPI communication is enabled (MODP). */
         } spi_cfg;
     };
@@ -670,14 +709,14 @@ typedef struct
                                                     * pull-up strength for peripheral 4. */
 
     /** Peripheral configurations (Disabled if null). */
-    npz_peripheral_config_s *peripherals[4];
+    const npz_peripheral_config_s *peripherals[4];
 
     /** System Config 2 (SYSCFG2) register for ADC clock configurartion. */
     uint8_t adc_ext_sampling_enable : 1; /**< Enables external ADC input sampling (ADC_IN pin).
                                           * (0: Disable ADC_IN, 1: Enable ADC_IN). */
     npz_adc_clk_e adc_clock_sel;     /**< Controls ADC clock. */
 
-    npz_adc_config_channels_s *adc_channels[2];
+    const npz_adc_config_channels_s *adc_channels[2];
 
 } npz_device_config_s;
 
@@ -941,6 +980,19 @@ npz_status_e npz_read_ADC_EXT(npz_register_adc_ext_s *adc_ext);
  */
 npz_status_e npz_write_SRAM(const uint8_t sram_reg, const uint8_t sram);
 
+/**
+ * @brief Writes consecutive SRAM registers, one register per I2C transfer.
+ *
+ * The device is only known to auto-increment the register address on reads. A block cut short by a failed write is
+ * left partly written.
+ *
+ * @param [in] sram_reg Register address in SRAM of the first byte.
+ * @param [in] data Bytes to write.
+ * @param [in] size Number of bytes, the block must end at or before REG_SRAM_END.
+ * @return npz_status_e Status, INVALID_PARAM if the block is outside SRAM.
+ */
+npz_status_e npz_write_SRAM_block(const uint8_t sram_reg, const uint8_t *data, const uint8_t size);
+
 /**
  * @brief Reads one SRAM register and writes it to npz_register_sram_s struct.
  *
@@ -1182,4 +1234,51 @@ npz_status_e npz_read_VALP(const npz_psw_e sw, npz_register_valp_s *valp);
  */
 npz_status_e npz_read_register(uint8_t register_address, void *buffer, size_t size);
 
+/**
+ * @brief Generic function to write consecutive device registers, one register per I2C transfer.
+ *
+ * The device is only known to auto-increment the register address on reads. Like the other write functions, the
+ * writes are recorded instead while capturing, see npz_capture_begin(). A failed write stops the range there.
+ *
+ * @param register_address The address of the first register to write.
+ * @param data The values to write, one per register from register_address on.
+ * @param size The number of registers to write, the last one must not lie past REG_SRAM_END.
+ * @return OK if the write operation is successful, INVALID_PARAM on a bad range, ERR otherwise.
+ */
+npz_status_e npz_write_register(uint8_t register_address, const void *data, size_t size);
+
+/**
+ * @brief Selects the device the register functions talk to.
+ *
+ * Defaults to bus 0 and NPZ_I2C_ADDRESS.
+ *
+ * @param bus Index of the HAL bus the device is on.
+ * @param address I2C address of the device, shifted left by 1 bit like NPZ_I2C_ADDRESS.
+ */
+void npz_set_device(uint8_t bus, uint8_t address);
+
+/**
+ * @brief Starts recording register writes into an image instead of sending them.
+ *
+ * Until npz_capture_end() is called, every write function appends its writes to the image and returns OK without
+ * touching the bus. Read functions are not affected.
+ *
+ * @param image Image to record into, cleared first.
+ */
+void npz_capture_begin(npz_image_s *image);
+
+/**
+ * @brief Stops recording register writes.
+ *
+ * @return OK if every write fit in the image, ERR otherwise.
+ */
+npz_status_e npz_capture_end(void);
+
+/**
+ * @brief Checks if register writes are being recorded, see npz_capture_begin().
+ *
+ * @return True between npz_capture_begin() and npz_capture_end().
+ */
+bool npz_capture_active(void);
+
 #endif /* __NPZ_H */
@@ -0,0 +1,92 @@
+/**
+ * @file npz_batch.h
+ * @brief Batched reporting of wake-up values.
+ *
+ * Readings are kept in a compact npz_batch_s, small enough for the retained store, and the transmit path is only
+ * brought up when the flush policy says so: every few wake-ups, when the batch is full, or when a wake reason or
+ * value is urgent. The transmitter is abstracted as an npz_batch_sink_s that is opened, written and closed once per
+ * flush, so its start-up and shutdown cost is paid once per batch rather than once per wake.
+ */
+
+#ifndef __NPZ_BATCH_H
+#define __NPZ_BATCH_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** One reading, 6 bytes. */
+typedef struct
+{
+    uint16_t raw;      /**< Raw value: VALPn for peripherals, ADC code for ADC events. */
+    uint16_t offset_s; /**< Seconds after npz_batch_s::base_seconds. */
+    uint8_t event;     /**< Bit number of the npz_event_e that produced the value. */
+} npz_batch_record_s;
+
+/** Readings waiting for the next flush, zero-initialized or reset with npz_batch_clear(). */
+typedef struct
+{
+    uint32_t base_seconds;                        /**< Time of the first record. */
+    uint8_t count;                                /**< Number of records. */
+    uint8_t wakes;                                /**< Wake-ups recorded since the last flush. */
+    uint8_t urgent : 1;                           /**< Set when an urgent reading is waiting. */
+    uint8_t span_full : 1;                        /**< Set when a record no longer fits in offset_s. */
+    uint8_t dropped;                              /**< Records lost because the batch was full. */
+    npz_batch_record_s records[NPZ_BATCH_SIZE];   /**< Records, oldest first. */
+} npz_batch_s;
+
+/** When to flush. */
+typedef struct
+{
+    uint8_t flush_wakes;     /**< Flush after this many wake-ups, 0 to not flush on count. */
+    uint16_t urgent_events;  /**< Bitmask of npz_event_e that flush right away. */
+    bool (*is_urgent)(const npz_history_sample_s *sample); /**< Value check that flushes right away, may be NULL. */
+} npz_batch_policy_s;
+
+/** Transmit path written to on a flush. */
+typedef struct
+{
+    bool (*open)(void *context);  /**< Powers up the transmitter, may be NULL. Returning false postpones the flush. */
+    npz_history_sink_t write;     /**< Takes the readings, converted to npz_history_sample_s. */
+    void (*close)(void *context); /**< Powers the transmitter down, may be NULL. */
+    void *context;                /**< Passed to the callbacks. */
+} npz_batch_sink_s;
+
+/**
+ * @brief Empties a batch.
+ */
+void npz_batch_clear(npz_batch_s *batch);
+
+/**
+ * @brief Adds the readings of a wake-up to a batch.
+ *
+ * When the batch is full, the oldest records are dropped to make room.
+ *
+ * @param [in,out] batch     Batch to add to.
+ * @param [in]     policy    Flush policy, used to flag urgent readings.
+ * @param [in]     wake      Values fetched by npz_process_wake().
+ * @param [in]     timestamp Time of the wake-up in seconds, e.g. npz_time_s::seconds.
+ *
+ * @return true if the batch is due for a flush, see npz_batch_due().
+ */
+bool npz_batch_record_wake(npz_batch_s *batch, const npz_batch_policy_s *policy, const npz_wake_s *wake,
+                           uint32_t timestamp);
+
+/**
+ * @brief Tells if a batch should be flushed now.
+ *
+ * @return true after policy->flush_wakes wake-ups, when the batch is full or when an urgent reading is waiting.
+ */
+bool npz_batch_due(const npz_batch_s *batch, const npz_batch_policy_s *policy);
+
+/**
+ * @brief Sends the readings of a batch to a sink and empties the batch.
+ *
+ * The sink is not opened when the batch holds no records.
+ *
+ * @return OK if the batch was sent, ERR if the sink could not be opened or refused the readings; the batch is kept
+ * in that case. INVALID_PARAM on NULL pointers.
+ */
+npz_status_e npz_batch_flush(npz_batch_s *batch, const npz_batch_sink_s *sink);
+
+#endif /* __NPZ_BATCH_H */
@@ -0,0 +1,63 @@
+/**
+ * @file npz_cobs.h
+ * @brief Consistent Overhead Byte Stuffing, for binary frames on a byte stream.
+ *
+ * An encoded frame contains no zero byte, so a zero marks the end of a frame and a receiver that lost bytes
+ * resynchronizes at the next one. The overhead is one byte per 254 bytes of payload, rounded up.
+ */
+
+#ifndef __NPZ_COBS_H
+#define __NPZ_COBS_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Largest encoded size of a payload of the given length, without the zero delimiter. */
+#define NPZ_COBS_MAX_ENCODED(length) ((length) + (length) / 254 + 1)
+
+/** Frame delimiter. */
+#define NPZ_COBS_DELIMITER 0x00
+
+/** State of a streaming decoder, zero-initialized at the start of a frame. */
+typedef struct
+{
+    uint8_t remaining;  /**< Data bytes left in the current block, 0 when the next byte is a block length. */
+    bool zero_pending;  /**< The current block ends with a zero, output once the frame goes on. */
+} npz_cobs_decoder_s;
+
+/** What npz_cobs_decode_byte() made of a received byte. */
+typedef enum
+{
+    NPZ_COBS_NONE,  /**< Nothing to output, e.g. a block length. */
+    NPZ_COBS_BYTE,  /**< One payload byte. */
+    NPZ_COBS_END,   /**< The delimiter, the decoder is ready for the next frame. */
+} npz_cobs_result_e;
+
+/**
+ * @brief Encodes a payload.
+ *
+ * @param [in]  data    Payload.
+ * @param [in]  length  Payload length.
+ * @param [out] encoded Receives the frame, at least NPZ_COBS_MAX_ENCODED(length) bytes. The delimiter is not
+ *                      added.
+ *
+ * @return Length of the encoded frame.
+ */
+size_t npz_cobs_encode(const uint8_t *data, size_t length, uint8_t *encoded);
+
+/**
+ * @brief Decodes a frame one received byte at a time, without buffering it.
+ *
+ * A frame cut short by the delimiter yields fewer bytes than were sent, so the payload needs its own length or CRC
+ * check.
+ *
+ * @param [in,out] decoder State, kept between calls.
+ * @param [in]     in      Received byte.
+ * @param [out]    out     Payload byte, set with NPZ_COBS_BYTE only.
+ *
+ * @return What the byte was.
+ */
+npz_cobs_result_e npz_cobs_decode_byte(npz_cobs_decoder_s *decoder, uint8_t in, uint8_t *out);
+
+#endif /* __NPZ_COBS_H */
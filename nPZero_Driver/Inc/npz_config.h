@@ -0,0 +1,308 @@
+/**
+ * @file npz_config.h
+ * @brief Compile-time build configuration of the npz driver.
+ *
+ * Each option has a default that keeps the full feature set. A production image that only uses some of the
+ * peripheral banks, one communication protocol or a subset of the polling modes can override the options on the
+ * compiler command line (for example -DNPZ_CFG_PERIPHERAL_MASK=0x04 -DNPZ_CFG_SPI_ENABLE=0). The driver then
+ * evaluates the corresponding tests as constants, so the compiler drops the branches for the unused banks,
+ * protocols and polling modes from configuration and logging.
+ *
+ * A configuration that uses a peripheral, protocol or polling mode that was left out of the build is rejected by
+ * npz_device_configure().
+ */
+
+#ifndef __NPZ_CONFIG_H
+#define __NPZ_CONFIG_H
+
+/*****************************************************************************
+ * Options
+ *****************************************************************************/
+
+/**
+ * @brief Peripheral banks included in the build, bit 0 for peripheral 1 up to bit 3 for peripheral 4.
+ */
+#ifndef NPZ_CFG_PERIPHERAL_MASK
+#define NPZ_CFG_PERIPHERAL_MASK 0x0F
+#endif
+
+/**
+ * @brief Set to 0 to leave the I2C peripheral path out of the build.
+ */
+#ifndef NPZ_CFG_I2C_ENABLE
+#define NPZ_CFG_I2C_ENABLE 1
+#endif
+
+/**
+ * @brief Set to 0 to leave the SPI peripheral path out of the build.
+ */
+#ifndef NPZ_CFG_SPI_ENABLE
+#define NPZ_CFG_SPI_ENABLE 1
+#endif
+
+/**
+ * @brief Polling modes included in the build, one bit per npz_polling_mode_e value.
+ *
+ * Bit 0: POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD,
+ * bit 1: POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD,
+ * bit 2: POLLING_MODE_PERIODIC_WAIT_INTERRUPT,
+ * bit 3: POLLING_MODE_ASYNC_WAIT_INTERRUPT.
+ */
+#ifndef NPZ_CFG_POLLING_MODE_MASK
+#define NPZ_CFG_POLLING_MODE_MASK 0x0F
+#endif
+
+/** Values of NPZ_LOG_LEVEL, each one includes the ones before. */
+#define NPZ_LOG_LEVEL_NONE  0
+#define NPZ_LOG_LEVEL_ERROR 1 /**< Failures the driver cannot recover from, e.g. a register that cannot be read. */
+#define NPZ_LOG_LEVEL_WARN  2
+#define NPZ_LOG_LEVEL_INFO  3 /**< State changes of the device: sleep and reset. */
+#define NPZ_LOG_LEVEL_DEBUG 4 /**< Wake-up sources and the failures recorded in npz_error_s. */
+#define NPZ_LOG_LEVEL_TRACE 5 /**< Register values. */
+
+/**
+ * @brief Most verbose diagnostic output of the driver that is compiled in.
+ *
+ * Statements above the level expand to nothing, so neither their format strings nor their arguments end up in the
+ * image, see NPZ_LOG_ERROR() and the others in npz_logs.h. Failures are reported through error codes at any level.
+ */
+#ifndef NPZ_LOG_LEVEL
+#define NPZ_LOG_LEVEL NPZ_LOG_LEVEL_ERROR
+#endif
+
+#if NPZ_LOG_LEVEL < NPZ_LOG_LEVEL_NONE || NPZ_LOG_LEVEL > NPZ_LOG_LEVEL_TRACE
+#error "NPZ_LOG_LEVEL must be one of the NPZ_LOG_LEVEL_ values"
+#endif
+
+/**
+ * @brief printf-style output the enabled diagnostic statements go to.
+ *
+ * NPZ_TLOG sends them as tokens in the binary log format and is printf() otherwise, see npz_token.h.
+ */
+#ifndef NPZ_LOG
+#define NPZ_LOG NPZ_TLOG
+#endif
+
+/** Values of NPZ_LOG_FORMAT. */
+#define NPZ_LOG_FORMAT_TEXT   0 /**< ASCII tables. */
+#define NPZ_LOG_FORMAT_BINARY 1 /**< COBS framed records, turned back into tables by tools/npz_logdecode. */
+
+/**
+ * @brief Output format of npz_log_configurations(), NPZ_LOG_FORMAT_TEXT or NPZ_LOG_FORMAT_BINARY.
+ */
+#ifndef NPZ_LOG_FORMAT
+#define NPZ_LOG_FORMAT NPZ_LOG_FORMAT_TEXT
+#endif
+
+/**
+ * @brief Called with a pointer to the npz_error_s each time the driver records a failure.
+ */
+#ifndef NPZ_ERROR_HOOK
+#define NPZ_ERROR_HOOK(error) ((void) 0)
+#endif
+
+/**
+ * @brief Maximum number of register writes an npz_image_s can record.
+ *
+ * A full configuration takes at most 63 register writes plus the SRAM bytes of the init sequences.
+ */
+#ifndef NPZ_IMAGE_MAX_WRITES
+#define NPZ_IMAGE_MAX_WRITES 224
+#endif
+
+/**
+ * @brief Maximum number of devices managed by one npz_fleet_s.
+ *
+ * The default covers the one device on the one bus of this board. Raise it, and NPZ_HAL_BUS_COUNT, on boards with
+ * more buses, each npz_fleet_s then holds NPZ_FLEET_MAX_IMAGES images of 2 * NPZ_IMAGE_MAX_WRITES bytes.
+ */
+#ifndef NPZ_FLEET_MAX_DEVICES
+#define NPZ_FLEET_MAX_DEVICES 1
+#endif
+
+/**
+ * @brief Maximum number of distinct configurations in one npz_fleet_s; devices with identical configurations share
+ * one register image.
+ */
+#ifndef NPZ_FLEET_MAX_IMAGES
+#define NPZ_FLEET_MAX_IMAGES 1
+#endif
+
+/**
+ * @brief Number of samples kept by an npz_history_s, must be a power of two.
+ */
+#ifndef NPZ_HISTORY_SIZE
+#define NPZ_HISTORY_SIZE 64
+#endif
+
+/**
+ * @brief Bytes at the end of the device SRAM kept for npz_retained, 0 to leave the whole SRAM to init sequences.
+ *
+ * npz_device_configure() reports NPZ_ERROR_SRAM_FULL rather than let init sequences run into this area. An
+ * application using npz_retained sets it to the size of its struct plus NPZ_RETAINED_HEADER_SIZE, see main.h.
+ */
+#ifndef NPZ_RETAINED_SIZE
+#define NPZ_RETAINED_SIZE 0
+#endif
+
+/**
+ * @brief Number of records an npz_batch_s holds, 6 bytes each in the retained store.
+ */
+#ifndef NPZ_BATCH_SIZE
+#define NPZ_BATCH_SIZE 6
+#endif
+
+/** Values of NPZ_CONSOLE_POLICY. */
+#define NPZ_CONSOLE_DROP_NEW  0 /**< Output that does not fit is dropped. */
+#define NPZ_CONSOLE_OVERWRITE 1 /**< The oldest unsent output is dropped to make room. */
+
+/**
+ * @brief Bytes of console output buffered for the UART, must be a power of two.
+ */
+#ifndef NPZ_CONSOLE_SIZE
+#define NPZ_CONSOLE_SIZE 512
+#endif
+
+/**
+ * @brief What npz_console_write() does when the buffer is full, NPZ_CONSOLE_DROP_NEW or NPZ_CONSOLE_OVERWRITE.
+ */
+#ifndef NPZ_CONSOLE_POLICY
+#define NPZ_CONSOLE_POLICY NPZ_CONSOLE_DROP_NEW
+#endif
+
+/**
+ * @brief Longest time the sleep commands wait for pending I2C and console output, in milliseconds.
+ *
+ * A full console buffer of 512 bytes takes about 45 ms at 115200 baud.
+ */
+#ifndef NPZ_SLEEP_DRAIN_TIMEOUT_MS
+#define NPZ_SLEEP_DRAIN_TIMEOUT_MS 1000
+#endif
+
+/**
+ * @brief Builds the register shell of npz_shell.h, 0 leaves it out.
+ */
+#ifndef NPZ_SHELL_ENABLE
+#define NPZ_SHELL_ENABLE 0
+#endif
+
+/**
+ * @brief Longest shell line in characters, without the line end.
+ */
+#ifndef NPZ_SHELL_LINE_SIZE
+#define NPZ_SHELL_LINE_SIZE 128
+#endif
+
+/**
+ * @brief Most commands on one shell line.
+ */
+#ifndef NPZ_SHELL_MAX_COMMANDS
+#define NPZ_SHELL_MAX_COMMANDS 16
+#endif
+
+/**
+ * @brief Longest time the shell waits for console space before a reply, in milliseconds; the reply is cut short after.
+ *
+ * A full console buffer of 512 bytes takes about 45 ms at 115200 baud.
+ */
+#ifndef NPZ_SHELL_REPLY_TIMEOUT_MS
+#define NPZ_SHELL_REPLY_TIMEOUT_MS 100
+#endif
+
+/**
+ * @brief Builds the configuration updates of npz_update.h, 0 leaves them out and frees their two flash pages.
+ */
+#ifndef NPZ_UPDATE_ENABLE
+#define NPZ_UPDATE_ENABLE 0
+#endif
+
+/**
+ * @brief Sends the binary wake report of npz_report.h on every wake-up, 0 sends none.
+ */
+#ifndef NPZ_REPORT_ENABLE
+#define NPZ_REPORT_ENABLE 0
+#endif
+
+#if (NPZ_CFG_PERIPHERAL_MASK & 0x0F) == 0
+#error "NPZ_CFG_PERIPHERAL_MASK must enable at least one peripheral"
+#endif
+
+#if !NPZ_CFG_I2C_ENABLE && !NPZ_CFG_SPI_ENABLE
+#error "At least one of NPZ_CFG_I2C_ENABLE and NPZ_CFG_SPI_ENABLE must be set"
+#endif
+
+#if (NPZ_CFG_POLLING_MODE_MASK & 0x0F) == 0
+#error "NPZ_CFG_POLLING_MODE_MASK must enable at least one polling mode"
+#endif
+
+#if (NPZ_HISTORY_SIZE) == 0 || ((NPZ_HISTORY_SIZE) & ((NPZ_HISTORY_SIZE) - 1)) != 0
+#error "NPZ_HISTORY_SIZE must be a power of two"
+#endif
+
+#if (NPZ_BATCH_SIZE) == 0 || (NPZ_BATCH_SIZE) > 255
+#error "NPZ_BATCH_SIZE must be between 1 and 255"
+#endif
+
+#if (NPZ_CONSOLE_SIZE) < 16 || (NPZ_CONSOLE_SIZE) > 32768 || ((NPZ_CONSOLE_SIZE) & ((NPZ_CONSOLE_SIZE) - 1)) != 0
+#error "NPZ_CONSOLE_SIZE must be a power of two between 16 and 32768"
+#endif
+
+#if (NPZ_SHELL_LINE_SIZE) < 16 || (NPZ_SHELL_LINE_SIZE) > 1024
+#error "NPZ_SHELL_LINE_SIZE must be between 16 and 1024"
+#endif
+
+#if (NPZ_SHELL_MAX_COMMANDS) == 0 || (NPZ_SHELL_MAX_COMMANDS) > 255
+#error "NPZ_SHELL_MAX_COMMANDS must be between 1 and 255"
+#endif
+
+#if (NPZ_RETAINED_SIZE) > 128
+#error "NPZ_RETAINED_SIZE cannot exceed the 128 bytes of device SRAM"
+#endif
+
+/*****************************************************************************
+ * Helpers
+ *****************************************************************************/
+
+/** True if the peripheral at the zero-based index is included in the build. */
+#define NPZ_CFG_PERIPHERAL_ENABLED(index) ((((NPZ_CFG_PERIPHERAL_MASK) >> (index)) & 0x01) != 0)
+
+/** True if the polling mode is included in the build. */
+#define NPZ_CFG_POLLING_MODE_ENABLED(mode) ((((NPZ_CFG_POLLING_MODE_MASK) >> (mode)) & 0x01) != 0)
+
+/** True if the communication protocol is included in the build. */
+#define NPZ_CFG_PROTOCOL_ENABLED(protocol)                                                                            \
+    (((protocol) == COM_I2C && NPZ_CFG_I2C_ENABLE) || ((protocol) == COM_SPI && NPZ_CFG_SPI_ENABLE))
+
+/**
+ * @brief Communication protocol of a peripheral configuration.
+ *
+ * Resolves to a constant when only one protocol is built in.
+ */
+#if NPZ_CFG_I2C_ENABLE && NPZ_CFG_SPI_ENABLE
+#define NPZ_CFG_PROTOCOL(config) ((config)->communication_protocol)
+#elif NPZ_CFG_I2C_ENABLE
+#define NPZ_CFG_PROTOCOL(config) COM_I2C
+#else
+#define NPZ_CFG_PROTOCOL(config) COM_SPI
+#endif
+
+/**
+ * @brief True if the polling mode makes the device address the peripheral (ADDRP).
+ *
+ * Every mode except POLLING_MODE_ASYNC_WAIT_INTERRUPT does. Constant when the mask holds only one kind of mode.
+ */
+#define NPZ_CFG_POLLING_HAS_ADDRESS(mode)                                                                             \
+    (((NPZ_CFG_POLLING_MODE_MASK) & 0x07) != 0 &&                                                                     \
+        (((NPZ_CFG_POLLING_MODE_MASK) & 0x08) == 0 || (mode) != POLLING_MODE_ASYNC_WAIT_INTERRUPT))
+
+/**
+ * @brief True if the polling mode reads a value and compares it to the thresholds (RREGP, THRUNP, THROVP).
+ *
+ * Constant when the mask holds only one kind of mode.
+ */
+#define NPZ_CFG_POLLING_HAS_THRESHOLD(mode)                                                                           \
+    (((NPZ_CFG_POLLING_MODE_MASK) & 0x03) != 0 &&                                                                     \
+        (((NPZ_CFG_POLLING_MODE_MASK) & 0x0C) == 0 ||                                                                 \
+            (mode) <= POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD))
+
+#endif /* __NPZ_CONFIG_H */
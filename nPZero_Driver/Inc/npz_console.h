@@ -0,0 +1,77 @@
+/**
+ * @file npz_console.h
+ * @brief Buffered console output on UART1.
+ *
+ * write() of the C library, and so printf, copies the output into a ring buffer of NPZ_CONSOLE_SIZE bytes and
+ * returns. The UART1 transmit interrupt drains the buffer a chunk at a time, so the caller does not wait for the
+ * line to go out at the baud rate. What happens when the buffer is full is set by NPZ_CONSOLE_POLICY.
+ *
+ * UART1 is only powered while the application has something to send, see uart_open() in main.c. Output written
+ * while it is off is kept in the buffer and goes out after the UART is initialized and npz_console_kick() or the
+ * next write is called.
+ *
+ * Bulk output such as a history export can bypass the buffer with npz_console_send(), which hands the whole
+ * buffer to DMA and reports when the last byte is out.
+ */
+
+#ifndef __NPZ_CONSOLE_H
+#define __NPZ_CONSOLE_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/**
+ * @brief Buffers output for the UART and starts sending it if the UART is on.
+ *
+ * @param [in] data  Bytes to send.
+ * @param [in] count Number of bytes.
+ *
+ * @return Number of bytes buffered. Less than count only with NPZ_CONSOLE_DROP_NEW and a full buffer.
+ */
+size_t npz_console_write(const void *data, size_t count);
+
+/** Called by npz_console_send() when the transfer is done, sent is false if the DMA failed before the last byte. */
+typedef void (*npz_console_done_f)(bool sent, uintptr_t context);
+
+/**
+ * @brief Sends a buffer by DMA, without copying it and without an interrupt per byte or chunk.
+ *
+ * Output written with npz_console_write() meanwhile stays in the ring and goes out after the buffer.
+ *
+ * @param [in] data    Bytes to send, must stay valid and unchanged until done is called.
+ * @param [in] size    Number of bytes, 1 to 65535.
+ * @param [in] done    Called from the UART interrupt once the last byte has left the shift register, e.g. to put
+ *                     the device to sleep, or once the DMA failed. May be NULL.
+ * @param [in] context Passed to done.
+ *
+ * @return True if the transfer started. False if the UART is off or still has buffered output to send, see
+ * npz_console_drain().
+ */
+bool npz_console_send(const void *data, size_t size, npz_console_done_f done, uintptr_t context);
+
+/**
+ * @brief Starts sending buffered output, e.g. after UART1_Initialize().
+ */
+void npz_console_kick(void);
+
+/**
+ * @brief Waits for the buffered output to leave the UART.
+ *
+ * @param [in] timeout Timeout in milliseconds.
+ *
+ * @return True once the buffer is empty and the last stop bit is out, false on timeout or if the UART is off.
+ */
+bool npz_console_drain(uint32_t timeout);
+
+/**
+ * @brief Free space in the buffer.
+ */
+size_t npz_console_free(void);
+
+/**
+ * @brief Number of bytes dropped because the buffer was full, saturating.
+ */
+uint16_t npz_console_dropped(void);
+
+#endif /* __NPZ_CONSOLE_H */
@@ -0,0 +1,56 @@
+/**
+ * @file npz_convert.h
+ * @brief Integer-only conversion of raw peripheral values to engineering units.
+ *
+ * A conversion is a Q16.16 scale in thousandths of the engineering unit per LSB plus an offset. The result is an
+ * integer in thousandths of the unit (milli-degC, mg, mV, ...), which npz_convert_format() turns into a decimal string
+ * without printf or floating point.
+ */
+
+#ifndef __NPZ_CONVERT_H
+#define __NPZ_CONVERT_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Builds a Q16.16 scale from a rational number of thousandths of a unit per LSB. */
+#define NPZ_CONVERT_SCALE_Q16(numerator, denominator) ((int32_t)(((int64_t)(numerator) << 16) / (denominator)))
+
+/** Scale and offset of one sensor value. */
+typedef struct
+{
+    int32_t scale_q16;    /**< Thousandths of the unit per LSB, Q16.16. */
+    int32_t offset_milli; /**< Added to the scaled value, in thousandths of the unit. */
+    bool is_signed;       /**< Raw value is a two's complement 16-bit number. */
+} npz_convert_s;
+
+/** AS6212 temperature, 0.0078125 degC per LSB, result in milli-degC. */
+extern const npz_convert_s npz_convert_as6212_temperature;
+
+/** 16-bit accelerometer axis at +/-2 g full scale, result in mg. */
+extern const npz_convert_s npz_convert_accel_2g;
+
+/**
+ * @brief Converts a raw 16-bit value.
+ *
+ * @param [in] conversion Scale and offset to apply.
+ * @param [in] raw        Raw value, e.g. npz_wake_s::valp.
+ *
+ * @return Value in thousandths of the unit, rounded to nearest.
+ */
+int32_t npz_convert_milli(const npz_convert_s *conversion, uint16_t raw);
+
+/**
+ * @brief Formats a value in thousandths of a unit as a decimal string, e.g. 23125 as "23.125".
+ *
+ * @param [in]  milli    Value in thousandths of the unit.
+ * @param [in]  decimals Number of decimals to keep, 0 to 3. The value is rounded to nearest.
+ * @param [out] buffer   Destination, always NUL-terminated when size is not 0.
+ * @param [in]  size     Size of the destination; 13 bytes hold any value with 3 decimals.
+ *
+ * @return Length of the string, or 0 if it did not fit.
+ */
+size_t npz_convert_format(int32_t milli, uint8_t decimals, char *buffer, size_t size);
+
+#endif /* __NPZ_CONVERT_H */
@@ -0,0 +1,30 @@
+/**
+ * @file npz_crc.h
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF, no reflection, no final XOR).
+ */
+
+#ifndef __NPZ_CRC_H
+#define __NPZ_CRC_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Initial value of a CRC computation. */
+#define NPZ_CRC16_INIT 0xFFFF
+
+/**
+ * @brief Adds bytes to a CRC-16/CCITT-FALSE.
+ *
+ * Pass NPZ_CRC16_INIT for the first block and the previous result for the following ones. The CRC of "123456789"
+ * is 0x29B1.
+ *
+ * @param [in] crc    CRC so far.
+ * @param [in] data   Bytes to add.
+ * @param [in] length Number of bytes.
+ *
+ * @return Updated CRC.
+ */
+uint16_t npz_crc16(uint16_t crc, const void *data, size_t length);
+
+#endif /* __NPZ_CRC_H */
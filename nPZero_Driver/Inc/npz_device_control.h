@@ -13,9 +13,63 @@
 #include "../Inc/npz.h"
 /** @endcond */
 
+/**
+ * @brief Returns the details of the last failure recorded by the driver.
+ *
+ * Every function in this module that returns false (or a status other than OK) records the cause, the register
+ * and the peripheral index involved.
+ *
+ * @return The last recorded error, cause NPZ_ERROR_NONE if nothing failed since the last configuration.
+ */
+npz_error_s npz_device_get_last_error(void);
+
+/**
+ * @brief Sets the cached MODP registers to those of a configuration the device already holds.
+ *
+ * npz_device_configure() fills the cache as it writes the device, captured configurations leave it alone. Call this
+ * instead when the device was configured before the host powered up, so its values decode with the right data type.
+ *
+ * @param [in] device_config Configuration held by the device, NULL to decode every peripheral as UINT16.
+ */
+void npz_device_set_modes(const npz_device_config_s *device_config);
+
+/**
+ * @brief Returns the MODP register last written to a peripheral by npz_device_configure(), or set with
+ * npz_device_set_modes().
+ *
+ * @param [in] index Zero-based peripheral index.
+ *
+ * @return The cached register, all zero (UINT16 data type) if the peripheral is not configured.
+ */
+npz_register_modp_s npz_device_get_mode(int index);
+
+/**
+ * @brief Decodes a VALP register pair according to the data type of a MODP register.
+ *
+ * UINT8 values are taken from VALPn_L, INT16 values are sign-extended. The byte order needs no handling here, the
+ * device applies swprreg before it stores the value.
+ *
+ * @param [in] modp   MODP register of the peripheral, see npz_device_get_mode().
+ * @param [in] valp_l VALPn_L register.
+ * @param [in] valp_h VALPn_H register.
+ *
+ * @return The value, from -32768 to 65535.
+ */
+int32_t npz_device_decode_value(npz_register_modp_s modp, uint8_t valp_l, uint8_t valp_h);
+
+/**
+ * @brief Decodes the four VALP register pairs of one snapshot with the cached MODP registers.
+ *
+ * @param [in]  snapshot VALP1_L to VALP4_H as read in one burst.
+ * @param [out] values   Value of each peripheral.
+ */
+void npz_device_decode_values(const uint8_t snapshot[8], int32_t values[4]);
+
 /**
  * @brief Reads the value from a specified peripheral.
  *
+ * The value is decoded according to the data type of the peripheral, see npz_device_decode_value().
+ *
  * @param [in]  psw_lp          The low power switch indicates which peripheral that will be written.
  * @param [in]  index           Index of the peripheral.
  * @param [out] peripheral_value Pointer to store the value read from the peripheral.
@@ -25,38 +79,83 @@
 bool npz_device_read_peripheral_value(npz_psw_e psw_lp, int index, int *peripheral_value);
 
 /**
- * @brief Handles the internal ADC and retrieves the relevant value.
+ * @brief Converts an internal ADC (VBAT) code to a voltage in constant time.
+ *
+ * Codes between the datasheet levels are interpolated, codes outside them read as the nearest level.
+ *
+ * @param [in] code ADC_CORE register value.
+ *
+ * @return Voltage in millivolts.
+ */
+uint16_t npz_adc_core_mv(uint8_t code);
+
+/**
+ * @brief Converts an external ADC (ADC_IN) code to a voltage in constant time.
+ *
+ * Codes between the datasheet levels are interpolated, codes outside them read as the nearest level.
+ *
+ * @param [in] code ADC_EXT register value.
+ *
+ * @return Voltage in millivolts.
+ */
+uint16_t npz_adc_ext_mv(uint8_t code);
+
+/**
+ * @brief Reads the internal ADC and converts the code to a voltage.
+ *
+ * @param [out] millivolts Voltage on VBAT in millivolts.
  *
  * @return True if the internal ADC was successfully handled, otherwise false.
  */
-bool  npz_device_handle_adc_internal(void);
+bool npz_device_handle_adc_internal(uint16_t *millivolts);
 
 /**
- * @brief Handles the external ADC and retrieves the relevant value.
+ * @brief Reads the external ADC and converts the code to a voltage.
+ *
+ * @param [out] millivolts Voltage on ADC_IN in millivolts, 0 if the external ADC is not enabled.
  *
  * @return True if the external ADC was successfully handled, otherwise false.
  */
-bool npz_device_handle_adc_external(void);
+bool npz_device_handle_adc_external(uint16_t *millivolts);
+
+/**
+ * @brief Waits until nothing the host has started is still on its way out.
+ *
+ * First the I2C transfers started with npz_hal_write_start() on every bus, then the application output through the
+ * hook registered with npz_hal_set_flush(). Returns as soon as both are done, so a power-gated host loses nothing
+ * when the device cuts it and stays up no longer than needed.
+ *
+ * @param [in] timeout Longest total wait in milliseconds.
+ *
+ * @return True if everything finished in time, false otherwise.
+ */
+bool npz_device_prepare_sleep(uint32_t timeout);
 
 /**
  * @brief Put the device into sleep mode.
  *
- * @param [in] device Pointer to the device structure.
+ * Pending output is drained first with npz_device_prepare_sleep() and NPZ_SLEEP_DRAIN_TIMEOUT_MS. The sleep command
+ * is sent even if that times out.
+ *
+ * @return True if the sleep command was written, otherwise false.
  */
-void npz_device_go_to_sleep(void);
+bool npz_device_go_to_sleep(void);
 
 /**
  * @brief Reset the device by software.
  *
- * @param [in] device Pointer to the device structure.
+ * @return True if the reset command was written, otherwise false.
  */
-void npz_device_soft_reset(void);
+bool npz_device_soft_reset(void);
 
 /**
  * @brief Setup npz device configuration.
  *
  * @param [in] npz_device_config_s Pointer to the device configuration structure.
+ *
+ * @return OK on success, INVALID_PARAM if the configuration was rejected, ERR if a register write failed. Details
+ * are available from npz_device_get_last_error().
  */
-void npz_device_configure(npz_device_config_s *device_config);
+npz_status_e npz_device_configure(const npz_device_config_s *device_config);
 
 #endif /* __NPZ_DEVICE_CONTROL_H */
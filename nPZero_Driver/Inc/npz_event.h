@@ -0,0 +1,88 @@
+/**
+ * @file npz_event.h
+ * @brief Dispatcher for the wake-up sources of the npz device.
+ *
+ * The application registers one handler per wake source. After each wake-up, npz_process_wake() fetches the status
+ * registers and the value registers in two bursts, decodes the wake sources into a bitmask and calls the handlers
+ * of the sources that fired. Handlers receive the fetched values and do not need to access the bus again.
+ */
+
+#ifndef __NPZ_EVENT_H
+#define __NPZ_EVENT_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Wake sources, one bit each in npz_wake_s::events. */
+typedef enum
+{
+    NPZ_EVENT_PER1_TRIGGER = 0x0001,   /**< Peripheral 1 triggered. */
+    NPZ_EVENT_PER2_TRIGGER = 0x0002,   /**< Peripheral 2 triggered. */
+    NPZ_EVENT_PER3_TRIGGER = 0x0004,   /**< Peripheral 3 triggered. */
+    NPZ_EVENT_PER4_TRIGGER = 0x0008,   /**< Peripheral 4 triggered. */
+    NPZ_EVENT_PER1_TIMEOUT = 0x0010,   /**< Global timeout elapsed before peripheral 1 triggered. */
+    NPZ_EVENT_PER2_TIMEOUT = 0x0020,   /**< Global timeout elapsed before peripheral 2 triggered. */
+    NPZ_EVENT_PER3_TIMEOUT = 0x0040,   /**< Global timeout elapsed before peripheral 3 triggered. */
+    NPZ_EVENT_PER4_TIMEOUT = 0x0080,   /**< Global timeout elapsed before peripheral 4 triggered. */
+    NPZ_EVENT_ADC_INTERNAL = 0x0100,   /**< Internal ADC channel (VBAT) triggered. */
+    NPZ_EVENT_ADC_EXTERNAL = 0x0200,   /**< External ADC channel (ADC_IN) triggered. */
+    NPZ_EVENT_GLOBAL_TIMEOUT = 0x0400, /**< Global timeout elapsed before any wake source triggered. */
+    NPZ_EVENT_RESET = 0x0800,          /**< The device was reset, see npz_wake_s::sta1 for the source. */
+} npz_event_e;
+
+/** Number of wake sources in npz_event_e. */
+#define NPZ_EVENT_COUNT 12
+
+/** Any of the peripheral trigger events. */
+#define NPZ_EVENT_PER_TRIGGER_ALL                                                                                     \
+    (NPZ_EVENT_PER1_TRIGGER | NPZ_EVENT_PER2_TRIGGER | NPZ_EVENT_PER3_TRIGGER | NPZ_EVENT_PER4_TRIGGER)
+
+/** Any of the per-peripheral timeout events. */
+#define NPZ_EVENT_PER_TIMEOUT_ALL                                                                                     \
+    (NPZ_EVENT_PER1_TIMEOUT | NPZ_EVENT_PER2_TIMEOUT | NPZ_EVENT_PER3_TIMEOUT | NPZ_EVENT_PER4_TIMEOUT)
+
+/** Everything fetched from the device on one wake-up. */
+typedef struct
+{
+    uint16_t events;          /**< Bitmask of npz_event_e that fired. */
+    npz_register_sta1_s sta1; /**< Status register 1 as read. */
+    npz_register_sta2_s sta2; /**< Status register 2 as read. */
+    uint16_t valp[4];         /**< Value of each peripheral, (VALPn_H << 8) | VALPn_L. */
+    int32_t value[4];         /**< Value of each peripheral decoded according to its data type. */
+    uint8_t adc_core;         /**< ADC_CORE code (VBAT). */
+    uint8_t adc_ext;          /**< ADC_EXT code (ADC_IN). */
+} npz_wake_s;
+
+/**
+ * @brief Handler for a wake source.
+ *
+ * @param [in] event The single event being dispatched.
+ * @param [in] index Zero-based peripheral index for peripheral events, -1 for the others.
+ * @param [in] wake  Values fetched on this wake-up.
+ */
+typedef void (*npz_event_handler_t)(npz_event_e event, int index, const npz_wake_s *wake);
+
+/**
+ * @brief Registers a handler for one or more wake sources.
+ *
+ * A later registration for the same source replaces the earlier one. Passing NULL removes the handler.
+ *
+ * @param [in] events  Bitmask of npz_event_e.
+ * @param [in] handler Handler to call.
+ */
+void npz_event_register(uint16_t events, npz_event_handler_t handler);
+
+/**
+ * @brief Reads the wake-up status of the device and calls the handlers of the sources that fired.
+ *
+ * STA1 and STA2 are read in one burst. When a peripheral or ADC source fired, VALP1 to ADC_EXT are read in a second
+ * burst. Handlers are called in the order of the bits in npz_event_e.
+ *
+ * @param [out] wake Optional, receives the fetched values. May be NULL.
+ *
+ * @return npz_status_e Status of the register reads.
+ */
+npz_status_e npz_process_wake(npz_wake_s *wake);
+
+#endif /* __NPZ_EVENT_H */
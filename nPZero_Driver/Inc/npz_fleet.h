@@ -0,0 +1,84 @@
+/**
+ * @file npz_fleet.h
+ * @brief Management of several npz devices on one or more I2C buses.
+ *
+ * npz_fleet_init() runs npz_device_configure() once per distinct configuration in capture mode and keeps the
+ * resulting register images. Devices with the same configuration share an image. npz_fleet_configure() and
+ * npz_fleet_sleep() then program all devices from the images, starting one transfer on every bus before waiting, so
+ * transfers on different buses overlap.
+ *
+ * This board has I2C1 only, so the defaults of npz_config.h size a fleet for a single device and the application
+ * programs it with npz_device_configure() directly. Enable further buses in Harmony, list them in the bus table of
+ * npz_hal.c and raise NPZ_HAL_BUS_COUNT and NPZ_FLEET_MAX_DEVICES to manage several devices.
+ */
+
+#ifndef __NPZ_FLEET_H
+#define __NPZ_FLEET_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** One device of a fleet. */
+typedef struct
+{
+    uint8_t bus;                        /**< Index of the HAL bus the device is on. */
+    uint8_t address;                    /**< I2C address, shifted left by 1 bit like NPZ_I2C_ADDRESS. */
+    const npz_device_config_s *config;  /**< Configuration of the device. */
+} npz_fleet_device_s;
+
+/** State of a fleet, filled by npz_fleet_init(). */
+typedef struct
+{
+    const npz_fleet_device_s *devices;             /**< Devices of the fleet. */
+    uint8_t count;                                 /**< Number of devices. */
+    npz_image_s images[NPZ_FLEET_MAX_IMAGES];      /**< Register images of the distinct configurations. */
+    uint8_t image_count;                           /**< Number of images in use. */
+    uint8_t image_of[NPZ_FLEET_MAX_DEVICES];       /**< Image used by each device. */
+    npz_status_e status[NPZ_FLEET_MAX_DEVICES];    /**< Result of the last fleet operation for each device. */
+} npz_fleet_s;
+
+/**
+ * @brief Builds the register images of a fleet.
+ *
+ * No bus traffic takes place. Configurations are compared by pointer first and by resulting image second, so
+ * separate but identical configurations also share an image.
+ *
+ * @param [out] fleet   Fleet state.
+ * @param [in]  devices Devices of the fleet, must stay valid while the fleet is used.
+ * @param [in]  count   Number of devices, at most NPZ_FLEET_MAX_DEVICES.
+ *
+ * @return OK, INVALID_PARAM if a configuration is rejected or there are too many devices or distinct
+ * configurations, ERR if an image overflows.
+ */
+npz_status_e npz_fleet_init(npz_fleet_s *fleet, const npz_fleet_device_s *devices, uint8_t count);
+
+/**
+ * @brief Programs every device of the fleet from its register image.
+ *
+ * @param [in,out] fleet Fleet state, per-device results are left in fleet->status.
+ *
+ * @return OK if every device was programmed, ERR otherwise.
+ */
+npz_status_e npz_fleet_configure(npz_fleet_s *fleet);
+
+/**
+ * @brief Reads STA1 and STA2 of every device of the fleet.
+ *
+ * @param [in,out] fleet  Fleet state, per-device results are left in fleet->status.
+ * @param [out]    status One entry per device.
+ *
+ * @return OK if every device was read, ERR otherwise.
+ */
+npz_status_e npz_fleet_read_status(npz_fleet_s *fleet, npz_status_s *status);
+
+/**
+ * @brief Puts every device of the fleet into sleep mode.
+ *
+ * @param [in,out] fleet Fleet state, per-device results are left in fleet->status.
+ *
+ * @return OK if every device accepted the sleep command, ERR otherwise.
+ */
+npz_status_e npz_fleet_sleep(npz_fleet_s *fleet);
+
+#endif /* __NPZ_FLEET_H */
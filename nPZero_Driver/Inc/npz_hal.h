@@ -30,9 +30,22 @@
 
 #define NPZ_I2C_ADDRESS			0x7a  // 0x3D npz I2c address shifted left by 1 bit
 #define I2C_TRANSMISSION_TIMEOUT_MS 1300
+#define NPZ_HAL_BUS_COUNT 1 // Number of I2C buses in the bus table of npz_hal.c
+#define NPZ_HAL_FLASH_PAGE_SIZE 1024 // Erase page of the PIC32MX250F128B program flash
 
 /** Enumerations. */
 
+/** Hook sending pending application output, see npz_hal_set_flush(). Returns true once it is out. */
+typedef bool (*npz_hal_flush_f)(uint32_t timeout);
+
+/** Called from the UART interrupt when a write of npz_hal_uart_write() or npz_hal_uart_dma_write() is done, sent is
+ * false if the DMA stopped on an error before the last byte. */
+typedef void (*npz_hal_uart_done_f)(bool sent);
+
+/** Called from the UART receive interrupt with each byte, ok is false for a byte with a framing, parity or overrun
+ * error. */
+typedef void (*npz_hal_uart_receive_f)(uint8_t byte, bool ok);
+
 
 /**
  * @brief Function to read from registers over I2C.
@@ -62,6 +75,158 @@ npz_status_e npz_hal_read(uint8_t slave_address, uint8_t slave_register,
 npz_status_e npz_hal_write(uint8_t slave_address, uint8_t *pData, uint16_t size,
 		uint32_t timeout);
 
+/**
+ * @brief Function to select the bus used by npz_hal_read() and npz_hal_write().
+ *
+ * @param [in] bus Index in the bus table of npz_hal.c, below NPZ_HAL_BUS_COUNT.
+ * @return npz_status_e Status
+ */
+npz_status_e npz_hal_select_bus(uint8_t bus);
+
+/**
+ * @brief Function to start a write over I2C without waiting for it to complete.
+ *
+ * @note pData must stay valid until npz_hal_wait() returns for the bus.
+ * @param [in] bus Index of the bus.
+ * @param [in] slave_address I2C Address for slave.
+ * @param [in] pData Pointer to data buffer to write.
+ * @param [in] size Size of data buffer to be sent.
+ * @return npz_status_e Status
+ */
+npz_status_e npz_hal_write_start(uint8_t bus, uint8_t slave_address, uint8_t *pData, uint16_t size);
+
+/**
+ * @brief Function to check if a bus has a transfer in progress.
+ *
+ * @param [in] bus Index of the bus.
+ * @return True while a transfer is in progress.
+ */
+bool npz_hal_is_busy(uint8_t bus);
+
+/**
+ * @brief Function to wait for the transfer on a bus to complete.
+ *
+ * @param [in] bus Index of the bus.
+ * @param [in] timeout Timeout in milliseconds.
+ * @return npz_status_e OK if the transfer completed without error.
+ */
+npz_status_e npz_hal_wait(uint8_t bus, uint32_t timeout);
+
+/**
+ * @brief Function to erase one page of program flash.
+ *
+ * @note The CPU stalls for the whole erase, about 20 ms, and interrupts are not serviced meanwhile.
+ * @param [in] page Address of the page as seen by the CPU, aligned to NPZ_HAL_FLASH_PAGE_SIZE.
+ * @return npz_status_e Status
+ */
+npz_status_e npz_hal_flash_erase(const void *page);
+
+/**
+ * @brief Function to program one 32-bit word of erased program flash.
+ *
+ * @note The CPU stalls for a few tens of microseconds, short enough for the UART receive FIFO.
+ * @param [in] address Address of the word as seen by the CPU, aligned to 4.
+ * @param [in] word Value to program.
+ * @return npz_status_e Status
+ */
+npz_status_e npz_hal_flash_write_word(const void *address, uint32_t word);
+
+/**
+ * @brief Function to check if the console UART is powered and can send.
+ *
+ * @return True while the UART is on.
+ */
+bool npz_hal_uart_is_on(void);
+
+/**
+ * @brief Function to keep the UART transmit and DMA interrupts from running, for data shared with the done
+ * callbacks.
+ *
+ * @note Calls do not nest. A write started while locked gets its interrupt from npz_hal_uart_unlock().
+ * @return State to pass to npz_hal_uart_unlock().
+ */
+uint32_t npz_hal_uart_lock(void);
+
+/**
+ * @brief Function to let the UART transmit and DMA interrupts run again after npz_hal_uart_lock().
+ *
+ * @param [in] state Value returned by npz_hal_uart_lock().
+ */
+void npz_hal_uart_unlock(uint32_t state);
+
+/**
+ * @brief Function to start sending bytes over the UART from its transmit interrupt.
+ *
+ * @note data must stay valid until done is called.
+ * @param [in] data Bytes to send.
+ * @param [in] size Number of bytes.
+ * @param [in] done Called once the bytes are in the transmit buffer, may be NULL.
+ * @return True if the write started, false while the UART is off or busy.
+ */
+bool npz_hal_uart_write(const uint8_t *data, uint16_t size, npz_hal_uart_done_f done);
+
+/**
+ * @brief Function to start sending bytes over the UART by DMA, without an interrupt per byte.
+ *
+ * @note data must stay valid until done is called.
+ * @param [in] data Bytes to send.
+ * @param [in] size Number of bytes.
+ * @param [in] done Called once the last byte has left the shift register or the DMA failed, may be NULL.
+ * @return True if the write started, false while the UART is off or busy.
+ */
+bool npz_hal_uart_dma_write(const void *data, uint16_t size, npz_hal_uart_done_f done);
+
+/**
+ * @brief Function to check if the UART has a write in progress.
+ *
+ * @return True until the done callback of the write has run.
+ */
+bool npz_hal_uart_is_busy(void);
+
+/**
+ * @brief Function to check if the last stop bit has left the UART.
+ *
+ * @return True once nothing is left in the transmit buffer and the shift register.
+ */
+bool npz_hal_uart_is_sent(void);
+
+/**
+ * @brief Function to start handing received UART bytes to a callback, one call per byte.
+ *
+ * @param [in] receive Called from the receive interrupt until npz_hal_uart_receive_stop().
+ * @return True if reception started, false while the UART is off or already receiving.
+ */
+bool npz_hal_uart_receive_start(npz_hal_uart_receive_f receive);
+
+/**
+ * @brief Function to stop the reception of npz_hal_uart_receive_start().
+ */
+void npz_hal_uart_receive_stop(void);
+
+/**
+ * @brief Function to get the time since power-up in milliseconds.
+ *
+ * @note Counted from the core timer, which wraps every 2^32 ticks, about 179 s at 48 MHz. The count stays
+ * continuous as long as it is read at least that often.
+ * @return Milliseconds since power-up.
+ */
+uint32_t npz_hal_get_ms(void);
+
+/**
+ * @brief Function to register the hook that sends pending application output, such as a console, before sleep.
+ *
+ * @param [in] flush Hook called by npz_hal_flush(), NULL for none.
+ */
+void npz_hal_set_flush(npz_hal_flush_f flush);
+
+/**
+ * @brief Function to send pending application output with the registered hook.
+ *
+ * @param [in] timeout Longest wait in milliseconds.
+ * @return True once the output is out or if no hook is registered, false otherwise.
+ */
+bool npz_hal_flush(uint32_t timeout);
+
 /**
  * @brief Function to initialize hardware dependent I2C interface.
  *
@@ -0,0 +1,118 @@
+/**
+ * @file npz_history.h
+ * @brief Ring buffer of the values read after each wake-up.
+ *
+ * npz_history_record_wake() appends one sample per peripheral trigger and ADC event of a wake-up. The ring keeps the
+ * latest NPZ_HISTORY_SIZE samples, overwriting the oldest ones. Samples not yet exported can be walked with an
+ * iterator or handed to a sink in bulk with npz_history_export(), so the host only has to bring up its link every
+ * few wake-ups.
+ *
+ * The history lives wherever the application places its npz_history_s, for example in a RAM section that is kept
+ * across resets.
+ */
+
+#ifndef __NPZ_HISTORY_H
+#define __NPZ_HISTORY_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Peripheral value of npz_history_sample_s for ADC samples. */
+#define NPZ_HISTORY_NO_PERIPHERAL 0xFF
+
+/** One value read after a wake-up. */
+typedef struct
+{
+    uint32_t timestamp; /**< Time of the wake-up, in the unit chosen by the caller. */
+    uint16_t raw;       /**< Raw value: VALPn for peripherals, ADC code for ADC events. */
+    uint16_t reason;    /**< The npz_event_e that produced the value. */
+    uint8_t peripheral; /**< Zero-based peripheral index, NPZ_HISTORY_NO_PERIPHERAL for ADC samples. */
+} npz_history_sample_s;
+
+/** Sample ring, zero-initialized or reset with npz_history_clear(). */
+typedef struct
+{
+    npz_history_sample_s samples[NPZ_HISTORY_SIZE]; /**< Storage, indexed by sequence number modulo the size. */
+    uint32_t head;                                  /**< Sequence number of the next sample to write. */
+    uint32_t exported;                              /**< Sequence number of the first sample not yet exported. */
+    uint16_t wakes;                                 /**< Wake-ups recorded since the last export. */
+} npz_history_s;
+
+/** Position in a history, see npz_history_iter_begin(). */
+typedef struct
+{
+    uint32_t next; /**< Sequence number of the next sample to return. */
+    uint32_t end;  /**< Sequence number one past the last sample to return. */
+} npz_history_iter_s;
+
+/**
+ * @brief Receives a run of consecutive samples from npz_history_export().
+ *
+ * @param [in] samples Samples, oldest first.
+ * @param [in] count   Number of samples.
+ * @param [in] context Pointer given to npz_history_export().
+ *
+ * @return true if the samples were taken, false to stop the export and keep them for the next one.
+ */
+typedef bool (*npz_history_sink_t)(const npz_history_sample_s *samples, uint16_t count, void *context);
+
+/**
+ * @brief Empties a history.
+ */
+void npz_history_clear(npz_history_s *history);
+
+/**
+ * @brief Appends one sample, overwriting the oldest one when the ring is full.
+ */
+void npz_history_append(npz_history_s *history, const npz_history_sample_s *sample);
+
+/**
+ * @brief Appends the values of a wake-up, one sample per peripheral trigger and ADC event.
+ *
+ * @param [in,out] history   History to append to.
+ * @param [in]     wake      Values fetched by npz_process_wake().
+ * @param [in]     timestamp Time of the wake-up.
+ */
+void npz_history_record_wake(npz_history_s *history, const npz_wake_s *wake, uint32_t timestamp);
+
+/**
+ * @brief Number of samples kept that were not exported yet.
+ */
+uint16_t npz_history_pending(const npz_history_s *history);
+
+/**
+ * @brief Number of samples that were overwritten before they could be exported.
+ */
+uint32_t npz_history_dropped(const npz_history_s *history);
+
+/**
+ * @brief Starts an iteration over the samples not exported yet, oldest first.
+ */
+void npz_history_iter_begin(const npz_history_s *history, npz_history_iter_s *iter);
+
+/**
+ * @brief Returns the next sample of an iteration.
+ *
+ * @param [in]     history History being iterated. Appending during the iteration is allowed; samples overwritten
+ *                         meanwhile are skipped.
+ * @param [in,out] iter    Iteration state.
+ *
+ * @return The sample, or NULL at the end of the iteration.
+ */
+const npz_history_sample_s *npz_history_iter_next(const npz_history_s *history, npz_history_iter_s *iter);
+
+/**
+ * @brief Hands all samples not exported yet to a sink and marks them exported.
+ *
+ * The sink is called at most twice, once per contiguous run of the ring.
+ *
+ * @param [in,out] history History to export.
+ * @param [in]     sink    Receiver of the samples.
+ * @param [in]     context Passed to the sink.
+ *
+ * @return OK if every pending sample was taken, ERR if the sink refused a run, INVALID_PARAM on NULL pointers.
+ */
+npz_status_e npz_history_export(npz_history_s *history, npz_history_sink_t sink, void *context);
+
+#endif /* __NPZ_HISTORY_H */
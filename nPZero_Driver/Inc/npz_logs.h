@@ -3,6 +3,16 @@
  * @brief This file contains functions for reading and logging configurations of the npz device, including global
  * settings, peripheral configurations, and ADC. The logging functions are designed to ensure that all configurations
  * are read correctly and presented in a standardized format for easier debugging and verification.
+ *
+ * With NPZ_LOG_FORMAT set to NPZ_LOG_FORMAT_BINARY the tables are sent as records instead of text, each record
+ * COBS encoded and followed by a zero byte. A record is five bytes: type, address, value and a 16-bit little endian
+ * timestamp, the milliseconds of npz_hal_get_ms() modulo 65536. Types are 0x01 for the start of a table (address
+ * is the table: 0 global, 1 status, 2 to 5 peripherals 1 to 4, 6 internal ADC, 7 external ADC), 0x02 for a register
+ * and 0x03 for the end of a table. A zero byte also precedes the start of each table, so text written in between stays apart.
+ * A register line takes 7 bytes on the wire instead of about 50. tools/npz_logdecode.c prints the tables again.
+ *
+ * The registers are read in two bursts by npz_dump_registers() before anything is printed. The same dump can be
+ * checked against a configuration with npz_verify_against(), without printing at all.
  */
 
 #ifndef __NPZ_LOGS_H
@@ -12,6 +22,99 @@
 #include "../../nPZero_xc32.X/main.h"
 /** @endcond */
 
+/**
+ * @name Diagnostic output by level
+ * Each takes the arguments of printf() and expands to NPZ_LOG() when NPZ_LOG_LEVEL includes its level, and to
+ * nothing otherwise.
+ * @{
+ */
+#if NPZ_LOG_LEVEL >= NPZ_LOG_LEVEL_ERROR
+#define NPZ_LOG_ERROR(...) NPZ_LOG(__VA_ARGS__)
+#else
+#define NPZ_LOG_ERROR(...) ((void) 0)
+#endif
+
+#if NPZ_LOG_LEVEL >= NPZ_LOG_LEVEL_WARN
+#define NPZ_LOG_WARN(...) NPZ_LOG(__VA_ARGS__)
+#else
+#define NPZ_LOG_WARN(...) ((void) 0)
+#endif
+
+#if NPZ_LOG_LEVEL >= NPZ_LOG_LEVEL_INFO
+#define NPZ_LOG_INFO(...) NPZ_LOG(__VA_ARGS__)
+#else
+#define NPZ_LOG_INFO(...) ((void) 0)
+#endif
+
+#if NPZ_LOG_LEVEL >= NPZ_LOG_LEVEL_DEBUG
+#define NPZ_LOG_DEBUG(...) NPZ_LOG(__VA_ARGS__)
+#else
+#define NPZ_LOG_DEBUG(...) ((void) 0)
+#endif
+
+#if NPZ_LOG_LEVEL >= NPZ_LOG_LEVEL_TRACE
+#define NPZ_LOG_TRACE(...) NPZ_LOG(__VA_ARGS__)
+#else
+#define NPZ_LOG_TRACE(...) ((void) 0)
+#endif
+/** @} */
+
+/** Registers read by npz_dump_registers(), 0x00 (REG_SLEEP_RST) to 0x59 (REG_ADC_EXT). */
+#define NPZ_DUMP_REGISTER_COUNT 0x5A
+
+/** SRAM bytes read by npz_dump_registers(), REG_SRAM_START to REG_SRAM_END. */
+#define NPZ_DUMP_SRAM_SIZE 128
+
+/** Register and SRAM content of a device. */
+typedef struct
+{
+    uint8_t reg[NPZ_DUMP_REGISTER_COUNT]; /**< Registers, indexed by address, unused addresses as the device reads. */
+    uint8_t sram[NPZ_DUMP_SRAM_SIZE];     /**< SRAM, indexed by address - REG_SRAM_START. */
+} npz_register_dump_s;
+
+/** Register whose content differs from the configuration, found by npz_verify_against(). */
+typedef struct
+{
+    uint8_t reg;      /**< Register (or SRAM) address. */
+    uint8_t expected; /**< Value written by npz_device_configure(). */
+    uint8_t actual;   /**< Value read from the device. */
+} npz_mismatch_s;
+
+/**
+ * @brief Reads all registers and the SRAM of the selected device, in one I2C transfer each.
+ *
+ * STA1 and STA2 are read as well, with the same effect as npz_read_STA1() and npz_read_STA2().
+ *
+ * @param [out] dump Content of the device.
+ *
+ * @return OK, INVALID_PARAM if dump is NULL, ERR if a transfer fails.
+ */
+npz_status_e npz_dump_registers(npz_register_dump_s *dump);
+
+/**
+ * @brief Value of a register or SRAM address in a dump, 0 for addresses that are not dumped.
+ */
+uint8_t npz_dump_value(const npz_register_dump_s *dump, uint8_t address);
+
+/**
+ * @brief Compares a dump with the registers a configuration writes.
+ *
+ * The configuration is run through npz_device_configure() in capture mode (see npz_capture_begin()), without bus
+ * traffic, and the last value written to each address is compared with the dump. SLEEP_RST, the status registers
+ * and the measured values are skipped.
+ *
+ * @param [in]  device_config Expected configuration.
+ * @param [in]  dump          Content read with npz_dump_registers().
+ * @param [out] mismatches    Differences in the order of the writes, may be NULL if max is 0.
+ * @param [in]  max           Size of mismatches.
+ * @param [out] count         Number of differences found, may exceed max.
+ *
+ * @return OK if the device holds the configuration, ERR if it differs or the configuration cannot be captured
+ * (count is then 0), INVALID_PARAM on NULL arguments or if npz_device_configure() rejects the configuration.
+ */
+npz_status_e npz_verify_against(const npz_device_config_s *device_config, const npz_register_dump_s *dump,
+                                npz_mismatch_s *mismatches, uint8_t max, uint8_t *count);
+
 /**
  * @brief Reads and logs the npz device configuration settings.
  *
@@ -21,6 +124,6 @@
  *
  * @param [in] device_config Pointer to the device configuration structure.
  */
-void npz_log_configurations(npz_device_config_s *device_config);
+void npz_log_configurations(const npz_device_config_s *device_config);
 
 #endif /* __NPZ_LOGS_H */
@@ -0,0 +1,83 @@
+/**
+ * @file npz_report.h
+ * @brief Binary wake report, one fixed-layout record per wake-up for the systems collecting the device output.
+ *
+ * The record is sent like the records of npz_logs.h, COBS encoded with a zero byte on both sides, so it shares the
+ * UART with text and log output. Its payload is NPZ_REPORT_SIZE bytes, multi-byte fields little endian:
+ *
+ *     offset  size  field
+ *      0      1     type, NPZ_REPORT_RECORD
+ *      1      1     layout version, NPZ_REPORT_VERSION
+ *      2      1     reset source, npz_resetsource_e
+ *      3      2     wake flags, npz_event_e bitmask
+ *      5      8     VALP1 to VALP4 as read, (VALPn_H << 8) | VALPn_L
+ *     13      1     ADC_CORE code
+ *     14      1     ADC_EXT code
+ *     15      4     wake counter
+ *     19      4     timestamp, whole seconds (npz_time_s)
+ *     23      2     timestamp, milliseconds
+ *     25      2     CRC-16 (npz_crc.h) of the bytes before it
+ *
+ * Later versions only add fields in front of the CRC, which always takes the last two bytes, so a parser reads the
+ * fields it knows from any version. tools/npz_reportlib.c parses the records on a Linux host.
+ */
+
+#ifndef __NPZ_REPORT_H
+#define __NPZ_REPORT_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Record type of the report, after the types of npz_logs.h and npz_token.h. */
+#define NPZ_REPORT_RECORD 0x05
+
+/** Layout version sent in each report. */
+#define NPZ_REPORT_VERSION 1
+
+/** Bytes of the encoded report, CRC included. */
+#define NPZ_REPORT_SIZE 27
+
+/** Contents of a report. */
+typedef struct
+{
+    uint8_t reset_source; /**< npz_resetsource_e from STA1. */
+    uint16_t events;      /**< Bitmask of npz_event_e. */
+    uint16_t valp[4];     /**< Value registers of the peripherals. */
+    uint8_t adc_core;     /**< ADC_CORE code (VBAT). */
+    uint8_t adc_ext;      /**< ADC_EXT code (ADC_IN). */
+    uint32_t wake_count;  /**< Wake-ups counted by the application. */
+    uint32_t seconds;     /**< Time of the wake-up, whole seconds. */
+    uint16_t millis;      /**< Time of the wake-up, milliseconds on top of seconds. */
+} npz_report_s;
+
+/**
+ * @brief Fills a report from the values of a wake-up.
+ *
+ * @param [out] report     Report to fill.
+ * @param [in]  wake       Values fetched by npz_process_wake().
+ * @param [in]  wake_count Wake-up counter of the application.
+ * @param [in]  time       Time of the wake-up, see npz_time.h.
+ */
+void npz_report_fill(npz_report_s *report, const npz_wake_s *wake, uint32_t wake_count, const npz_time_s *time);
+
+/**
+ * @brief Lays a report out as described above, CRC included.
+ *
+ * @param [in]  report  Report to encode.
+ * @param [out] payload NPZ_REPORT_SIZE bytes.
+ */
+void npz_report_encode(const npz_report_s *report, uint8_t *payload);
+
+/**
+ * @brief Sends the report of a wake-up to the console in one frame.
+ *
+ * @param [in] wake       Values fetched by npz_process_wake().
+ * @param [in] wake_count Wake-up counter of the application.
+ * @param [in] time       Time of the wake-up.
+ *
+ * @return OK, INVALID_PARAM on NULL arguments, ERR if the console dropped the frame.
+ */
+npz_status_e npz_report_send(const npz_wake_s *wake, uint32_t wake_count, const npz_time_s *time);
+
+#endif /* __NPZ_REPORT_H */
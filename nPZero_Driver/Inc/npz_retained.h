@@ -0,0 +1,59 @@
+/**
+ * @file npz_retained.h
+ * @brief Host state kept in the device SRAM while the host is powered down.
+ *
+ * The last NPZ_RETAINED_SIZE bytes of the device SRAM hold one application-defined struct behind a 3-byte header
+ * (struct size and CRC-16). The device stays powered while it sleeps, so a host that loses its RAM on every sleep
+ * cycle can restore wake counters, last values or configuration signatures with a single burst read.
+ *
+ * SRAM content after a power-on reset is undefined; npz_retained_load() then fails the CRC check and the host starts
+ * from defaults.
+ */
+
+#ifndef __NPZ_RETAINED_H
+#define __NPZ_RETAINED_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Bytes taken by the header in front of the retained struct. */
+#define NPZ_RETAINED_HEADER_SIZE 3
+
+/** Largest struct that fits in the retained area. */
+#define NPZ_RETAINED_MAX_DATA ((NPZ_RETAINED_SIZE) > NPZ_RETAINED_HEADER_SIZE ?                                       \
+                                   (NPZ_RETAINED_SIZE) - NPZ_RETAINED_HEADER_SIZE : 0)
+
+/** SRAM address of the retained area. */
+#define NPZ_RETAINED_ADDRESS ((uint8_t)(REG_SRAM_END + 1 - (NPZ_RETAINED_SIZE)))
+
+/**
+ * @brief Restores the retained struct.
+ *
+ * @param [out] data Struct to fill, left untouched unless OK is returned.
+ * @param [in]  size Size of the struct, at most NPZ_RETAINED_MAX_DATA.
+ *
+ * @return OK if a valid struct of this size was stored, ERR if the area is empty, corrupted or holds a struct of
+ * another size, INVALID_PARAM if the struct does not fit.
+ */
+npz_status_e npz_retained_load(void *data, uint8_t size);
+
+/**
+ * @brief Stores the retained struct.
+ *
+ * The area is written one byte per transfer, see npz_write_SRAM_block(). A save that is cut short leaves a CRC that
+ * does not match, so the next npz_retained_load() fails instead of returning a mix of old and new values.
+ *
+ * @param [in] data Struct to store.
+ * @param [in] size Size of the struct, at most NPZ_RETAINED_MAX_DATA.
+ *
+ * @return OK, ERR if the write failed, INVALID_PARAM if the struct does not fit.
+ */
+npz_status_e npz_retained_save(const void *data, uint8_t size);
+
+/**
+ * @brief Marks the retained area empty, so the next npz_retained_load() fails.
+ */
+npz_status_e npz_retained_invalidate(void);
+
+#endif /* __NPZ_RETAINED_H */
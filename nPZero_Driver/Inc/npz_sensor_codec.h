@@ -0,0 +1,130 @@
+/**
+ * @file npz_sensor_codec.h
+ * @brief Sensor codecs: everything the driver needs to know about one sensor model.
+ *
+ * A codec holds the bus settings, init and read sequences, data format and unit conversion of a sensor.
+ * npz_sensor_build_config() combines it with application parameters (polling, thresholds in engineering units, wait
+ * times) into an npz_peripheral_config_s, and npz_sensor_decode() turns a polled value back into engineering units.
+ * Supporting a new sensor means adding a codec, not hand-tuning registers.
+ */
+
+#ifndef __NPZ_SENSOR_CODEC_H
+#define __NPZ_SENSOR_CODEC_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Description of one sensor model. */
+typedef struct
+{
+    const char *name;                    /**< Human readable sensor name. */
+    const char *unit;                    /**< Engineering unit of the decoded value, e.g. "mg". */
+    uint8_t decimals;                    /**< Decimals worth printing, see npz_convert_format(). */
+    npz_com_protocol_e protocol;         /**< Bus the sensor is on. */
+    npz_data_type_e data_type;           /**< Format of the polled value (MODP). */
+    npz_endianess_e endianness;          /**< Byte order of the polled value (MODP). */
+    npz_multibyte_e multi_byte_transfer; /**< Sequential addresses sent as one transfer (MODP). */
+    const uint8_t *init_sequence;        /**< I2C: address/value pairs, SPI: bytes sent at init (NCMDP). */
+    uint8_t init_sequence_num;           /**< Length of init_sequence in bytes. */
+    const uint8_t *read_sequence;        /**< SPI only: bytes sent to read the value (ADDRP). */
+    uint8_t read_sequence_num;           /**< Length of read_sequence in bytes. */
+    uint8_t read_register;               /**< I2C only: register holding the value (RREGP). */
+    uint8_t default_address;             /**< I2C only: 7-bit address used when the parameters give none. */
+    npz_spimod_e spi_mode;               /**< SPI only: bus mode (MODP). */
+    const npz_convert_s *conversion;     /**< Raw value to thousandths of the unit. */
+    uint8_t block_size;                  /**< I2C only: bytes of the full sample set, 0 if the value is all of it. */
+} npz_sensor_codec_s;
+
+/** Largest block_size of a codec. */
+#define NPZ_SENSOR_BLOCK_MAX 16
+
+/** Application side settings of a sensor, everything the codec does not fix. */
+typedef struct
+{
+    npz_power_mode_e power_mode;                 /**< Peripheral power mode (CFGP). */
+    npz_polling_mode_e polling_mode;             /**< Peripheral polling mode (CFGP). */
+    npz_power_switch_mode_e power_switch_mode;   /**< Power switch mode (CFGP). */
+    npz_interrupt_pin_mode_e interrupt_pin_mode; /**< Interrupt pin mode (CFGP). */
+    npz_comparison_mode_e comparison_mode;       /**< Threshold comparison mode (MODP). */
+    uint16_t polling_period;                     /**< Polling period (PERP), must not be zero. */
+    int32_t threshold_over_milli;                /**< Over threshold in thousandths of the codec unit. */
+    int32_t threshold_under_milli;               /**< Under threshold in thousandths of the codec unit. */
+    uint8_t time_to_wait;                        /**< Wait time (TWTP). */
+    npz_pre_wait_time_e pre_wait_time;           /**< Pre-initialization wait time (TCFGP). */
+    npz_post_wait_time_e post_wait_time;         /**< Post-initialization wait time (TCFGP). */
+    uint8_t i2c_address;                         /**< I2C only: 7-bit address, 0 for the codec default. */
+    uint8_t wake_on_nak : 1;                     /**< I2C only: wake up on NAK (MODP). */
+    uint8_t num_of_retries_on_nak : 2;           /**< I2C only: retries on NAK (TCFGP). */
+} npz_sensor_params_s;
+
+/** AS6212 temperature sensor on I2C, 0.0078125 degC per LSB. */
+extern const npz_sensor_codec_s npz_sensor_as6212;
+
+/** DevKit SPI accelerometer, X axis at +/-2 g full scale. */
+extern const npz_sensor_codec_s npz_sensor_devkit_accel;
+
+/**
+ * @brief Fills a peripheral configuration from a codec and application parameters.
+ *
+ * @param [in]  codec  Sensor codec, must stay valid while the configuration is used.
+ * @param [in]  params Application settings.
+ * @param [out] config Configuration to fill, suitable for npz_device_config_s::peripherals.
+ *
+ * @return OK, or INVALID_PARAM if a pointer is NULL or the codec protocol is left out by npz_config.h.
+ */
+npz_status_e npz_sensor_build_config(const npz_sensor_codec_s *codec, const npz_sensor_params_s *params,
+                                     npz_peripheral_config_s *config);
+
+/**
+ * @brief Converts a threshold in engineering units to the raw register value of a sensor.
+ *
+ * @param [in] codec Sensor codec.
+ * @param [in] milli Threshold in thousandths of the codec unit.
+ *
+ * @return Raw value, rounded to nearest and clamped to the range of the codec data type.
+ */
+uint16_t npz_sensor_threshold(const npz_sensor_codec_s *codec, int32_t milli);
+
+/**
+ * @brief Converts a polled value to engineering units.
+ *
+ * @param [in] codec Sensor codec.
+ * @param [in] raw   Polled value, e.g. npz_wake_s::valp.
+ *
+ * @return Value in thousandths of the codec unit.
+ */
+int32_t npz_sensor_decode(const npz_sensor_codec_s *codec, uint16_t raw);
+
+/**
+ * @brief Reads the full sample set of a sensor from the host after a wake-up.
+ *
+ * The npz device only keeps one value per peripheral. While the host is awake, a peripheral whose power switch is
+ * on in normal mode is still powered, so the host reads the rest of the sample set in one burst instead of having
+ * the sensor polled again. The sensor is read from the polled register onwards on the bus selected with
+ * npz_hal_select_bus(). The host has no SPI port on this board, so only I2C sensors have a block.
+ *
+ * @param [in]  codec  Codec of the sensor, block_size must not be 0.
+ * @param [in]  device Device configuration holding the peripheral.
+ * @param [in]  index  Zero-based peripheral index.
+ * @param [out] data   Receives codec->block_size bytes as sent by the sensor.
+ * @param [in]  size   Size of data.
+ *
+ * @return OK, ERR if the transfer failed, INVALID_PARAM if the codec has no block or is not I2C, data is too small,
+ * or the peripheral is not configured or not powered in normal mode.
+ */
+npz_status_e npz_sensor_read_block(const npz_sensor_codec_s *codec, const npz_device_config_s *device, int index,
+                                   uint8_t *data, uint8_t size);
+
+/**
+ * @brief Extracts one 16-bit value from a block read with npz_sensor_read_block().
+ *
+ * @param [in] codec Sensor codec, gives the byte order.
+ * @param [in] block Block as read.
+ * @param [in] n     Zero-based value index, below codec->block_size / 2.
+ *
+ * @return Raw value, suitable for npz_sensor_decode().
+ */
+uint16_t npz_sensor_block_value(const npz_sensor_codec_s *codec, const uint8_t *block, uint8_t n);
+
+#endif /* __NPZ_SENSOR_CODEC_H */
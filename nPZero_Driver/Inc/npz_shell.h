@@ -0,0 +1,54 @@
+/**
+ * @file npz_shell.h
+ * @brief Register shell on UART1, to inspect and tune a deployed device without reflashing.
+ *
+ * A line holds one or more commands separated by ';' and ends with CR or LF. Numbers are hexadecimal, with or
+ * without 0x.
+ *
+ *     r <reg> [count]          Reads count registers from reg on, 1 by default.
+ *     w <reg> <value> [...]    Writes the values to reg and the registers after it.
+ *     snapshot                 Reads REG_SLEEP_RST to REG_ADC_EXT.
+ *     sram                     Reads REG_SRAM_START to REG_SRAM_END.
+ *     apply                    Programs the configuration passed to npz_shell_run().
+ *     sleep                    Ends the session once the line is done.
+ *
+ * The whole line is parsed before anything goes out on the bus, so a typo runs nothing. Runs of reads that continue
+ * where the previous command stopped then share one I2C transfer: "r 17; r 18 2" is a single 3-register read. Writes go
+ * one register per transfer, see npz_write_register(). Each read still answers on its own, one "reg: value ..." row per
+ * 16 registers, and the line ends with "OK", or "ERR n" for the first command that failed, 0 if the line was too long.
+ * Commands after a failure are not run.
+ *
+ * The shell does not echo; enable local echo in the terminal. Register writes stay in the device until it is
+ * configured again.
+ */
+
+#ifndef __NPZ_SHELL_H
+#define __NPZ_SHELL_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/**
+ * @brief Answers commands received on UART1 until "sleep" or until no byte arrived for idle_timeout.
+ *
+ * UART1 must be on. Receives through npz_hal_uart_receive_start(), which takes the UART receiver for the session.
+ *
+ * @param [in] device_config Configuration programmed by "apply", may be NULL if there is none.
+ * @param [in] idle_timeout  Time without input that ends the session, in milliseconds.
+ *
+ * @return OK once the session is over, INVALID_PARAM if UART1 is off or its receiver is busy.
+ */
+npz_status_e npz_shell_run(const npz_device_config_s *device_config, uint32_t idle_timeout);
+
+/**
+ * @brief Runs one command line, as if received by npz_shell_run().
+ *
+ * @param [in,out] line          Command line without the line end, split up while it is parsed.
+ * @param [in]     device_config Configuration programmed by "apply", may be NULL.
+ *
+ * @return True if the line contained "sleep" and ran without error.
+ */
+bool npz_shell_execute(char *line, const npz_device_config_s *device_config);
+
+#endif /* __NPZ_SHELL_H */
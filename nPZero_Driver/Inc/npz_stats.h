@@ -0,0 +1,64 @@
+/**
+ * @file npz_stats.h
+ * @brief Streaming statistics of peripheral values in integer arithmetic.
+ *
+ * Count, minimum, maximum, mean and variance are updated with Welford's method, one sample at a time, without
+ * keeping the samples. The mean is kept in Q8 fixed point and the sum of squared deviations in Q8 with 64 bits, so
+ * the update costs two divisions and one 64-bit multiplication. An npz_stats_s is 24 bytes and contains no pointers,
+ * so it can be kept in the retained store and reset at the start of every reporting window.
+ *
+ * Values are peripheral values decoded according to their data type, see npz_wake_s::value, so they range from
+ * -32768 to 65535.
+ */
+
+#ifndef __NPZ_STATS_H
+#define __NPZ_STATS_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Statistics of one value stream, zero-initialized or reset with npz_stats_reset(). */
+typedef struct
+{
+    int64_t m2_q8;   /**< Sum of squared deviations from the mean, Q8. */
+    int32_t mean_q8; /**< Mean, Q8. */
+    int32_t min;     /**< Smallest value. */
+    int32_t max;     /**< Largest value. */
+    uint16_t count;  /**< Number of values, saturates at UINT16_MAX. */
+} npz_stats_s;
+
+/**
+ * @brief Starts a new window.
+ */
+void npz_stats_reset(npz_stats_s *stats);
+
+/**
+ * @brief Adds one value.
+ */
+void npz_stats_add(npz_stats_s *stats, int32_t value);
+
+/**
+ * @brief Adds the decoded value of every peripheral that triggered on a wake-up.
+ *
+ * @param [in,out] stats One entry per peripheral.
+ * @param [in]     wake  Values fetched by npz_process_wake().
+ */
+void npz_stats_add_wake(npz_stats_s stats[4], const npz_wake_s *wake);
+
+/**
+ * @brief Mean of the values, rounded to nearest, 0 if there are none.
+ */
+int32_t npz_stats_mean(const npz_stats_s *stats);
+
+/**
+ * @brief Sample variance of the values, rounded to nearest, 0 for fewer than two values.
+ */
+uint32_t npz_stats_variance(const npz_stats_s *stats);
+
+/**
+ * @brief Sample standard deviation of the values, rounded to nearest.
+ */
+uint32_t npz_stats_stddev(const npz_stats_s *stats);
+
+#endif /* __NPZ_STATS_H */
@@ -0,0 +1,63 @@
+/**
+ * @file npz_time.h
+ * @brief Elapsed time reconstruction across host sleeps, without an RTC.
+ *
+ * The host keeps an npz_time_s in retained storage and updates it twice per cycle: npz_time_add_awake() adds its own
+ * measured on-time before it goes to sleep, npz_time_on_wake() adds the sleep duration derived from the wake reason
+ * and the configuration the device slept with.
+ *
+ * - A global timeout wake-up happens exactly TOUT system clock periods after sleep started.
+ * - A peripheral trigger happens between the first polling period and TOUT. The midpoint is used and half the
+ *   interval goes into the error bound.
+ * - After a device reset the elapsed time is unknown and so is the error bound.
+ */
+
+#ifndef __NPZ_TIME_H
+#define __NPZ_TIME_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Error bound of a time that lost track, e.g. after a device reset. */
+#define NPZ_TIME_ERROR_UNKNOWN UINT32_MAX
+
+/** Reconstructed time since npz_time_reset(), small enough for the retained store. */
+typedef struct
+{
+    uint32_t seconds;  /**< Whole seconds. */
+    uint32_t error_ms; /**< Bound on the accumulated error, NPZ_TIME_ERROR_UNKNOWN if unbounded. */
+    uint16_t millis;   /**< Milliseconds on top of seconds, 0 to 999. */
+} npz_time_s;
+
+/**
+ * @brief Restarts a time at zero with no error.
+ */
+void npz_time_reset(npz_time_s *time);
+
+/**
+ * @brief Adds the host on-time of the cycle that is ending.
+ *
+ * @param [in,out] time      Time to advance.
+ * @param [in]     awake_ms  Time the host measured between wake-up and the sleep command.
+ */
+void npz_time_add_awake(npz_time_s *time, uint32_t awake_ms);
+
+/**
+ * @brief Adds the duration of the sleep that just ended.
+ *
+ * @param [in,out] time   Time to advance.
+ * @param [in]     config Configuration the device slept with, NULL if it is not known.
+ * @param [in]     wake   Wake-up status from npz_process_wake().
+ */
+void npz_time_on_wake(npz_time_s *time, const npz_device_config_s *config, const npz_wake_s *wake);
+
+/**
+ * @brief Converts a number of system clock periods to milliseconds, rounded to nearest.
+ *
+ * @param [in] config Configuration holding the system clock source and divider.
+ * @param [in] ticks  Number of periods, e.g. TOUT or PERP.
+ */
+uint32_t npz_time_ticks_to_ms(const npz_device_config_s *config, uint32_t ticks);
+
+#endif /* __NPZ_TIME_H */
@@ -0,0 +1,53 @@
+/**
+ * @file npz_token.h
+ * @brief Tokenized logging: format strings stay on the host, the target sends a numeric ID and the arguments.
+ *
+ * NPZ_TLOG() takes a printf format and integer arguments. With NPZ_LOG_FORMAT set to NPZ_LOG_FORMAT_BINARY, the
+ * format string is placed in the .npz_tokens section, which is kept in the ELF file but not loaded into flash, and
+ * its offset in that section is the token. At run time only the token and the arguments are sent, in a COBS frame
+ * like the records of npz_logs.h and with a zero byte on both sides: type 0x04, the token as 16-bit little endian,
+ * then each argument as an unsigned LEB128 varint of its 32-bit value. tools/npz_logdecode.c reads the section from
+ * the ELF file of the build and prints the lines again. With NPZ_LOG_FORMAT_TEXT, NPZ_TLOG() is printf().
+ *
+ * Arguments are converted to 32 bits, so %s and floating point conversions are not supported.
+ */
+
+#ifndef __NPZ_TOKEN_H
+#define __NPZ_TOKEN_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+/** Most arguments sent with one token, further ones are dropped. */
+#define NPZ_TOKEN_MAX_ARGS 8
+
+/**
+ * Section of the format strings. The flags after the name make it a non-allocated section, the trailing '#'
+ * comments out the flags the compiler appends.
+ */
+#define NPZ_TOKEN_SECTION ".npz_tokens,\"\",@progbits #"
+
+#if NPZ_LOG_FORMAT == NPZ_LOG_FORMAT_BINARY
+#define NPZ_TLOG(format, ...)                                                                                         \
+    do                                                                                                                \
+    {                                                                                                                 \
+        static const char npz_token_format[] __attribute__((section(NPZ_TOKEN_SECTION), used)) = format;            \
+        const uint32_t npz_token_args[] = {0, ##__VA_ARGS__};                                                         \
+        npz_token_send((uint16_t)(uintptr_t)npz_token_format, &npz_token_args[1],                                    \
+                       sizeof(npz_token_args) / sizeof(npz_token_args[0]) - 1);                                       \
+    } while (0)
+#else
+#define NPZ_TLOG(format, ...) printf(format, ##__VA_ARGS__)
+#endif
+
+/**
+ * @brief Sends a token and its arguments, used by NPZ_TLOG().
+ *
+ * @param [in] token Offset of the format string in the .npz_tokens section.
+ * @param [in] args  Arguments, converted to 32 bits.
+ * @param [in] count Number of arguments.
+ */
+void npz_token_send(uint16_t token, const uint32_t *args, size_t count);
+
+#endif /* __NPZ_TOKEN_H */
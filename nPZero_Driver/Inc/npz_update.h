@@ -0,0 +1,134 @@
+/**
+ * @file npz_update.h
+ * @brief Configuration updates over UART1, applied while they stream in and kept in program flash.
+ *
+ * An update is one COBS frame (see npz_cobs.h) with this payload:
+ *
+ *     kind                        NPZ_UPDATE_FULL or NPZ_UPDATE_DELTA.
+ *     reg, count, value[count]    Records, any number, each writing count consecutive registers from reg on.
+ *     crc                         CRC-16 (npz_crc.h) of everything before it, least significant byte first.
+ *
+ * Each record goes to the device one register per I2C transfer as soon as its last value arrives, and on to program
+ * flash, so neither the configuration struct nor the frame is held in RAM. Records may only write registers that
+ * npz_device_configure() writes for the base configuration, which keeps the sleep command, the status and value
+ * registers and the retained area out of reach. A frame that fails a check, the CRC at its end included, is undone by
+ * programming the device again from the records stored before it.
+ *
+ * Stored records apply on top of the base configuration. A FULL update replaces them, a DELTA update adds to them.
+ * The application calls npz_update_configure() where it would call npz_device_configure(). Two flash pages take
+ * turns, so a reset during an update leaves the previous records in place.
+ *
+ * Every frame is answered with "OK" or "ERR n" and CR LF, n being an npz_update_result_e. tools/npz_update.c builds
+ * the frames on a Linux host.
+ */
+
+#ifndef __NPZ_UPDATE_H
+#define __NPZ_UPDATE_H
+
+/** @cond */
+#include "../../nPZero_xc32.X/main.h"
+/** @endcond */
+
+#define NPZ_UPDATE_FULL  0x01 /**< The records replace the stored ones. */
+#define NPZ_UPDATE_DELTA 0x02 /**< The records are added to the stored ones. */
+
+/** Most registers one record writes. */
+#define NPZ_UPDATE_RECORD_MAX 64
+
+/** Bytes of records a flash page holds, after its 8-byte header. */
+#define NPZ_UPDATE_STORE_SIZE (NPZ_HAL_FLASH_PAGE_SIZE - 8)
+
+/** Outcome of an update frame. */
+typedef enum
+{
+    NPZ_UPDATE_OK = 0,
+    NPZ_UPDATE_ERR_FORMAT = 1,   /**< Unknown kind, record count out of range, or the frame ends inside a record. */
+    NPZ_UPDATE_ERR_REGISTER = 2, /**< A record writes a register the base configuration does not. */
+    NPZ_UPDATE_ERR_CRC = 3,      /**< The CRC does not match, e.g. bytes were lost. */
+    NPZ_UPDATE_ERR_SPACE = 4,    /**< The stored records would exceed NPZ_UPDATE_STORE_SIZE, send a FULL update. */
+    NPZ_UPDATE_ERR_BUS = 5,      /**< A register write failed. */
+    NPZ_UPDATE_ERR_FLASH = 6,    /**< Programming the flash failed. */
+} npz_update_result_e;
+
+/** State of the update receiver, set up by npz_update_begin(). */
+typedef struct
+{
+    const npz_device_config_s *config;     /**< Base configuration. */
+    uint8_t allowed[32];                   /**< Registers records may write, one bit per address. */
+    npz_cobs_decoder_s decoder;
+    uint16_t received;                     /**< Payload bytes of the frame so far. */
+    uint8_t tail[2];                       /**< Last two payload bytes, held back because they may be the CRC. */
+    uint16_t crc;                          /**< CRC of the payload bytes processed. */
+    npz_update_result_e result;            /**< First error of the frame, the rest of it is only checked. */
+    bool touched;                          /**< The device was written since the frame started. */
+    uint8_t header;                        /**< Bytes of the header of the current record received, 0 to 2. */
+    uint8_t reg;                           /**< First register of the current record. */
+    uint8_t count;                         /**< Registers of the current record. */
+    uint8_t filled;                        /**< Values of the current record received. */
+    uint8_t values[NPZ_UPDATE_RECORD_MAX];
+    uint8_t page;                          /**< Flash page being written, the other one holds the stored records. */
+    uint16_t stored;                       /**< Bytes of records written to the page. */
+    uint8_t word[4];                       /**< Bytes waiting for a full flash word. */
+} npz_update_s;
+
+/**
+ * @brief Prepares to receive updates.
+ *
+ * Erases the spare flash page if needed, which stalls the CPU for about 20 ms, so call it before the host starts
+ * sending.
+ *
+ * @param [out] update        Receiver state.
+ * @param [in]  device_config Base configuration, must stay valid while updates are received.
+ * @param [in]  base          Writes of npz_device_configure() for device_config, recorded with npz_capture_begin().
+ *
+ * @return OK, INVALID_PARAM on NULL arguments or an overflowed image, ERR if the page cannot be erased.
+ */
+npz_status_e npz_update_begin(npz_update_s *update, const npz_device_config_s *device_config,
+                              const npz_image_s *base);
+
+/**
+ * @brief Processes one byte received on the UART.
+ *
+ * @param [in,out] update Receiver state.
+ * @param [in]     byte   Received byte.
+ * @param [out]    result Outcome of the frame, set only when true is returned.
+ *
+ * @return True when the byte ended a frame.
+ */
+bool npz_update_feed(npz_update_s *update, uint8_t byte, npz_update_result_e *result);
+
+/**
+ * @brief Receives updates on UART1 until no byte arrived for idle_timeout.
+ *
+ * UART1 must be on. Receives through npz_hal_uart_receive_start(), like npz_shell_run().
+ *
+ * @param [in]  device_config Base configuration.
+ * @param [in]  base          Writes of npz_device_configure() for device_config, see npz_update_begin().
+ * @param [in]  idle_timeout  Time without input that ends the session, in milliseconds.
+ * @param [out] changed       Set if an update was stored, may be NULL.
+ *
+ * @return OK once the session is over, INVALID_PARAM if UART1 is off or its receiver is busy, or the status of
+ * npz_update_begin().
+ */
+npz_status_e npz_update_run(const npz_device_config_s *device_config, const npz_image_s *base, uint32_t idle_timeout,
+                            bool *changed);
+
+/**
+ * @brief Programs the device with a configuration followed by the stored records.
+ *
+ * @param [in] device_config Base configuration.
+ *
+ * @return Status of npz_device_configure(), or ERR if a stored record cannot be written.
+ */
+npz_status_e npz_update_configure(const npz_device_config_s *device_config);
+
+/**
+ * @brief Adds the stored records to a CRC, for a signature of the configuration the device ends up with.
+ *
+ * @param [in] crc CRC so far, see npz_crc16().
+ *
+ * @return Updated CRC, unchanged if nothing is stored.
+ */
+uint16_t npz_update_signature(uint16_t crc);
+
+#endif /* __NPZ_UPDATE_H */
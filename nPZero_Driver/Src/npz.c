@@ -22,10 +22,68 @@
 
 #include "../../nPZero_xc32.X/main.h"
 
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+static uint8_t m_address = NPZ_I2C_ADDRESS; /**< Address of the device the accessors talk to. */
+static npz_image_s *m_capture = NULL;       /**< Image recording the writes, NULL when writing to the device. */
+
 /*****************************************************************************
  * Private Methods
  *****************************************************************************/
 
+/**
+ * @brief Sends a register write to the selected device, or appends it to the capture image.
+ */
+static npz_status_e write_registers(uint8_t *pData, uint16_t size, uint32_t timeout)
+{
+    if (m_capture == NULL)
+    {
+        return npz_hal_write(m_address, pData, size, timeout);
+    }
+
+    // pData is a register address followed by the values written from that address on
+    for (uint16_t i = 1; i < size; i++)
+    {
+        if (m_capture->count >= NPZ_IMAGE_MAX_WRITES)
+        {
+            m_capture->overflow = true;
+            return ERR;
+        }
+
+        m_capture->reg[m_capture->count] = (uint8_t)(pData[0] + i - 1);
+        m_capture->value[m_capture->count] = pData[i];
+        m_capture->count++;
+    }
+
+    return OK;
+}
+
+/**
+ * @brief Writes consecutive registers, one register per transfer.
+ *
+ * The device is only known to auto-increment the register address on reads, so a range is never sent as one
+ * multi-byte write.
+ */
+static npz_status_e write_range(uint8_t first_register, const uint8_t *data, size_t size)
+{
+    uint8_t transmitData[2];
+
+    for (size_t i = 0; i < size; i++)
+    {
+        transmitData[0] = (uint8_t)(first_register + i);
+        transmitData[1] = data[i];
+
+        if (write_registers(transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS) != OK)
+        {
+            return ERR;
+        }
+    }
+
+    return OK;
+}
+
 /*****************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -34,28 +92,28 @@ npz_status_e npz_write_SLEEP_RST(uint8_t sleep_rst_value)
 {
     uint8_t transmitData[] = {REG_SLEEP_RST, sleep_rst_value};
 
-    return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
+    return write_registers(transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_SLEEP_RST(uint8_t *sleep_rst_value)
 {
-    return npz_hal_read(NPZ_I2C_ADDRESS, REG_SLEEP_RST, sleep_rst_value, 1, I2C_TRANSMISSION_TIMEOUT_MS);
+    return npz_hal_read(m_address, REG_SLEEP_RST, sleep_rst_value, 1, I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_ID(uint8_t *id)
 {
-    return npz_hal_read(NPZ_I2C_ADDRESS, REG_ID, id, 1, I2C_TRANSMISSION_TIMEOUT_MS);
+    return npz_hal_read(m_address, REG_ID, id, 1, I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_STA1(npz_register_sta1_s *sta1) 
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_STA1, (uint8_t*) sta1, 1,
+	return npz_hal_read(m_address, REG_STA1, (uint8_t*) sta1, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_STA2(npz_register_sta2_s *sta2) 
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_STA2, (uint8_t*) sta2, 1,
+	return npz_hal_read(m_address, REG_STA2, (uint8_t*) sta2, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -71,13 +129,13 @@ npz_status_e npz_write_PSWCTL(const npz_register_pswctl_s pswctl)
 	transmitData[1] |= pswctl.pswh_mode << 4;
 	transmitData[1] |= pswctl.psw_en_vn << 6;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_PSWCTL(npz_register_pswctl_s *pswctl)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_PSWCTL, (uint8_t*) pswctl, 1,
+	return npz_hal_read(m_address, REG_PSWCTL, (uint8_t*) pswctl, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -94,13 +152,12 @@ npz_status_e npz_write_SYSCFG1(const npz_register_syscfg1_s syscfg1)
     transmitData[1] |= syscfg1.adc_ext_wakeup_enable << 5;
     transmitData[1] |= syscfg1.wake_up_any_or_all << 6;
 
-    return npz_hal_write(
-        NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
+    return write_registers(transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_SYSCFG1(npz_register_syscfg1_s *syscfg1)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_SYSCFG1, (uint8_t*) syscfg1, 1,
+	return npz_hal_read(m_address, REG_SYSCFG1, (uint8_t*) syscfg1, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -114,12 +171,12 @@ npz_status_e npz_write_SYSCFG2(const npz_register_syscfg2_s syscfg2)
     transmitData[1] |= syscfg2.adc_ext_on << 4;
     transmitData[1] |= syscfg2.adc_clk_sel << 5;
 
-    return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
+    return write_registers(transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_SYSCFG2(npz_register_syscfg2_s *syscfg2)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_SYSCFG2, (uint8_t*) syscfg2, 1,
+	return npz_hal_read(m_address, REG_SYSCFG2, (uint8_t*) syscfg2, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -134,12 +191,12 @@ npz_status_e npz_write_SYSCFG3(const npz_register_syscfg3_s syscfg3)
     transmitData[1] |= syscfg3.xo_clkout_div << 4;
     transmitData[1] |= syscfg3.sclk_sel_status << 7;
 
-    return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
+    return write_registers(transmitData, sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_SYSCFG3(npz_register_syscfg3_s *syscfg3)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_SYSCFG3, (uint8_t*) syscfg3, 1,
+	return npz_hal_read(m_address, REG_SYSCFG3, (uint8_t*) syscfg3, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -147,14 +204,14 @@ npz_status_e npz_write_TOUT(const npz_register_tout_s tout)
 {
 	uint8_t transmitData[2] = { REG_TOUT_L, tout.tout_l };
 
-	if (npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	if (write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS) != OK) {
 		return ERR;
 	} else {
 		transmitData[0] = REG_TOUT_H;
 		transmitData[1] = tout.tout_h;
 
-		return npz_hal_write(NPZ_I2C_ADDRESS, transmitData,
+		return write_registers(transmitData,
 				sizeof(transmitData), I2C_TRANSMISSION_TIMEOUT_MS);
 	}
 }
@@ -163,11 +220,11 @@ npz_status_e npz_read_TOUT(npz_register_tout_s *tout)
 {
 	npz_status_e success = ERR;
 
-	success = npz_hal_read(NPZ_I2C_ADDRESS, REG_TOUT_L, &tout->tout_l, 1,
+	success = npz_hal_read(m_address, REG_TOUT_L, &tout->tout_l, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 
 	if (success == OK) {
-		success = npz_hal_read(NPZ_I2C_ADDRESS, REG_TOUT_H, &tout->tout_h, 1,
+		success = npz_hal_read(m_address, REG_TOUT_H, &tout->tout_h, 1,
 				I2C_TRANSMISSION_TIMEOUT_MS);
 	}
 
@@ -187,13 +244,13 @@ npz_status_e npz_write_INTCFG(const npz_register_intcfg_s intcfg)
 	transmitData[1] |= intcfg.pu_int4 << 6;
 	transmitData[1] |= intcfg.pu_s_int4 << 7;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_INTCFG(npz_register_intcfg_s *intcfg)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_INTCFG, (uint8_t*) intcfg, 1,
+	return npz_hal_read(m_address, REG_INTCFG, (uint8_t*) intcfg, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -203,13 +260,13 @@ npz_status_e npz_write_THROVA1(const npz_register_throva1_s throva1)
 	transmitData[0] = REG_THROVA1;
 	transmitData[1] = throva1.throva;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_THROVA1(npz_register_throva1_s *throva1)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_THROVA1, (uint8_t*) throva1, 1,
+	return npz_hal_read(m_address, REG_THROVA1, (uint8_t*) throva1, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -219,13 +276,13 @@ npz_status_e npz_write_THROVA2(const npz_register_throva2_s throva2)
 	transmitData[0] = REG_THROVA2;
 	transmitData[1] = throva2.throva;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_THROVA2(npz_register_throva2_s *throva2)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_THROVA2, (uint8_t*) throva2, 1,
+	return npz_hal_read(m_address, REG_THROVA2, (uint8_t*) throva2, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -235,13 +292,13 @@ npz_status_e npz_write_THRUNA1(const npz_register_thruna1_s thruna1)
 	transmitData[0] = REG_THRUNA1;
 	transmitData[1] = thruna1.thruna;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_THRUNA1(npz_register_thruna1_s *thruna1)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_THRUNA1, (uint8_t*) thruna1, 1,
+	return npz_hal_read(m_address, REG_THRUNA1, (uint8_t*) thruna1, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -251,25 +308,25 @@ npz_status_e npz_write_THRUNA2(const npz_register_thruna2_s thruna2)
 	transmitData[0] = REG_THRUNA2;
 	transmitData[1] = thruna2.thruna;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_THRUNA2(npz_register_thruna2_s *thruna2)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_THRUNA2, (uint8_t*) thruna2, 1,
+	return npz_hal_read(m_address, REG_THRUNA2, (uint8_t*) thruna2, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_ADC_CORE(npz_register_adc_core_s *adc_core)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_ADC_CORE, &adc_core->adc_core, 1,
+	return npz_hal_read(m_address, REG_ADC_CORE, &adc_core->adc_core, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
 npz_status_e npz_read_ADC_EXT(npz_register_adc_ext_s *adc_ext)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, REG_ADC_EXT, &adc_ext->adc_ext, 1,
+	return npz_hal_read(m_address, REG_ADC_EXT, &adc_ext->adc_ext, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -281,13 +338,24 @@ npz_status_e npz_write_SRAM(const uint8_t sram_reg, const uint8_t SRAM)
 	transmitData[1] = SRAM;
 
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
+npz_status_e npz_write_SRAM_block(const uint8_t sram_reg, const uint8_t *data, const uint8_t size)
+{
+	if (data == NULL || size == 0 || sram_reg < REG_SRAM_START
+			|| sram_reg + size - 1 > REG_SRAM_END)
+	{
+		return INVALID_PARAM;
+	}
+
+	return write_range(sram_reg, data, size);
+}
+
 npz_status_e npz_read_SRAM(const uint8_t sram_reg, npz_register_sram_s *SRAM)
 {
-	return npz_hal_read(NPZ_I2C_ADDRESS, sram_reg, (uint8_t*) SRAM, 128,
+	return npz_hal_read(m_address, sram_reg, (uint8_t*) SRAM, 128,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -318,7 +386,7 @@ npz_status_e npz_write_CFGP(const npz_psw_e sw, const npz_register_cfgp_s cfgp)
 	transmitData[1] |= cfgp.pswmod << 4;
 	transmitData[1] |= cfgp.intmod << 6;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -344,7 +412,7 @@ npz_status_e npz_read_CFGP(const npz_psw_e sw, npz_register_cfgp_s *cfgp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) cfgp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) cfgp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -377,7 +445,7 @@ npz_status_e npz_write_MODP(const npz_psw_e sw, const npz_register_modp_s modp)
 	transmitData[1] |= modp.swprreg << 5;
 	transmitData[1] |= modp.spimod << 6;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -403,7 +471,7 @@ npz_status_e npz_read_MODP(const npz_psw_e sw, npz_register_modp_s *modp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) modp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) modp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -446,7 +514,7 @@ npz_status_e npz_write_PERP(const npz_psw_e sw, const npz_register_perp_s perp)
 		break;
 	}
 
-	if (npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	if (write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS) != OK) {
 		return ERR;
 	}
@@ -454,7 +522,7 @@ npz_status_e npz_write_PERP(const npz_psw_e sw, const npz_register_perp_s perp)
 	transmitData[0] = reg_h;
 	transmitData[1] = perp.perp_h;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -485,11 +553,11 @@ npz_status_e npz_read_PERP(const npz_psw_e sw, npz_register_perp_s *perp)
 		break;
 	}
 
-	success = npz_hal_read(NPZ_I2C_ADDRESS, reg_l, &perp->perp_l, 1,
+	success = npz_hal_read(m_address, reg_l, &perp->perp_l, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 
 	if (success == OK) {
-		success = npz_hal_read(NPZ_I2C_ADDRESS, reg_h, &perp->perp_h, 1,
+		success = npz_hal_read(m_address, reg_h, &perp->perp_h, 1,
 				I2C_TRANSMISSION_TIMEOUT_MS);
 	}
 
@@ -520,7 +588,7 @@ npz_status_e npz_write_NCMDP(const npz_psw_e sw, const npz_register_ncmdp_s ncmd
 
 	transmitData[1] |= ncmdp.ncmdp;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -546,7 +614,7 @@ npz_status_e npz_read_NCMDP(const npz_psw_e sw, npz_register_ncmdp_s *ncmdp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) ncmdp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) ncmdp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -575,7 +643,7 @@ npz_status_e npz_write_ADDRP(const npz_psw_e sw, const npz_register_addrp_s addr
 	transmitData[1] |= addrp.addrp;
 	transmitData[1] |= addrp.spi_en << 7;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -601,7 +669,7 @@ npz_status_e npz_read_ADDRP(const npz_psw_e sw, npz_register_addrp_s *addrp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) addrp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) addrp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -629,7 +697,7 @@ npz_status_e npz_write_RREGP(const npz_psw_e sw, const npz_register_rregp_s rreg
 
 	transmitData[1] |= rregp.rregp;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -655,7 +723,7 @@ npz_status_e npz_read_RREGP(const npz_psw_e sw, npz_register_rregp_s *rregp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) rregp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) rregp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -689,7 +757,7 @@ npz_status_e npz_write_THROVP(const npz_psw_e sw, const npz_register_throvp_s th
 
 	transmitData[1] = throvp.throvp_l;
 
-	if (npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	if (write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS) != OK) {
 		return ERR;
 	}
@@ -697,7 +765,7 @@ npz_status_e npz_write_THROVP(const npz_psw_e sw, const npz_register_throvp_s th
 	transmitData[0] = reg_h;
 	transmitData[1] = throvp.throvp_h;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -728,11 +796,11 @@ npz_status_e npz_read_THROVP(const npz_psw_e sw, npz_register_throvp_s *throvp)
 		break;
 	}
 
-	success = npz_hal_read(NPZ_I2C_ADDRESS, reg_l, &throvp->throvp_l, 1,
+	success = npz_hal_read(m_address, reg_l, &throvp->throvp_l, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 
 	if (success == OK) {
-		success = npz_hal_read(NPZ_I2C_ADDRESS, reg_h, &throvp->throvp_h, 1,
+		success = npz_hal_read(m_address, reg_h, &throvp->throvp_h, 1,
 				I2C_TRANSMISSION_TIMEOUT_MS);
 	}
 
@@ -769,7 +837,7 @@ npz_status_e npz_write_THRUNP(const npz_psw_e sw, const npz_register_thrunp_s th
 
 	transmitData[1] = thrunp.thrunp_l;
 
-	if (npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	if (write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS) != OK) {
 		return ERR;
 	}
@@ -777,7 +845,7 @@ npz_status_e npz_write_THRUNP(const npz_psw_e sw, const npz_register_thrunp_s th
 	transmitData[0] = reg_h;
 	transmitData[1] = thrunp.thrunp_h;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -808,11 +876,11 @@ npz_status_e npz_read_THRUNP(const npz_psw_e sw, npz_register_thrunp_s *thrunp)
 		break;
 	}
 
-	success = npz_hal_read(NPZ_I2C_ADDRESS, reg_l, &thrunp->thrunp_l, 1,
+	success = npz_hal_read(m_address, reg_l, &thrunp->thrunp_l, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 
 	if (success == OK) {
-		success = npz_hal_read(NPZ_I2C_ADDRESS, reg_h, &thrunp->thrunp_h, 1,
+		success = npz_hal_read(m_address, reg_h, &thrunp->thrunp_h, 1,
 				I2C_TRANSMISSION_TIMEOUT_MS);
 	}
 
@@ -843,7 +911,7 @@ npz_status_e npz_write_TWTP(const npz_psw_e sw, const npz_register_twtp_s twtp)
 
 	transmitData[1] |= twtp.twtp;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -869,7 +937,7 @@ npz_status_e npz_read_TWTP(const npz_psw_e sw, npz_register_twtp_s *twtp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) twtp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) twtp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -901,7 +969,7 @@ npz_status_e npz_write_TCFGP(const npz_psw_e sw, const npz_register_tcfgp_s tcfg
 	transmitData[1] |= tcfgp.tinit_ext << 3;
 	transmitData[1] |= tcfgp.i2cret << 4;
 
-	return npz_hal_write(NPZ_I2C_ADDRESS, transmitData, sizeof(transmitData),
+	return write_registers(transmitData, sizeof(transmitData),
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -927,7 +995,7 @@ npz_status_e npz_read_TCFGP(const npz_psw_e sw, npz_register_tcfgp_s *tcfgp)
 		break;
 	}
 
-	return npz_hal_read(NPZ_I2C_ADDRESS, reg, (uint8_t*) tcfgp, 1,
+	return npz_hal_read(m_address, reg, (uint8_t*) tcfgp, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 }
 
@@ -958,11 +1026,11 @@ npz_status_e npz_read_VALP(const npz_psw_e sw, npz_register_valp_s *valp)
 		break;
 	}
 
-	success = npz_hal_read(NPZ_I2C_ADDRESS, reg_l, &valp->valp_l, 1,
+	success = npz_hal_read(m_address, reg_l, &valp->valp_l, 1,
 			I2C_TRANSMISSION_TIMEOUT_MS);
 
 	if (success == OK) {
-		success = npz_hal_read(NPZ_I2C_ADDRESS, reg_h, &valp->valp_h, 1,
+		success = npz_hal_read(m_address, reg_h, &valp->valp_h, 1,
 				I2C_TRANSMISSION_TIMEOUT_MS);
 	}
 
@@ -971,5 +1039,42 @@ npz_status_e npz_read_VALP(const npz_psw_e sw, npz_register_valp_s *valp)
 
 npz_status_e npz_read_register(uint8_t register_address, void *buffer, size_t size)
 {
-    return npz_hal_read(NPZ_I2C_ADDRESS, register_address, (uint8_t *) buffer, size, I2C_TRANSMISSION_TIMEOUT_MS);
+    return npz_hal_read(m_address, register_address, (uint8_t *) buffer, size, I2C_TRANSMISSION_TIMEOUT_MS);
+}
+
+npz_status_e npz_write_register(uint8_t register_address, const void *data, size_t size)
+{
+    if (data == NULL || size == 0 || register_address + size - 1 > REG_SRAM_END)
+    {
+        return INVALID_PARAM;
+    }
+
+    return write_range(register_address, (const uint8_t *) data, size);
+}
+
+void npz_set_device(uint8_t bus, uint8_t address)
+{
+    npz_hal_select_bus(bus);
+    m_address = address;
+}
+
+void npz_capture_begin(npz_image_s *image)
+{
+    image->count = 0;
+    image->overflow = false;
+    m_capture = image;
+}
+
+npz_status_e npz_capture_end(void)
+{
+    npz_status_e status = (m_capture != NULL && !m_capture->overflow) ? OK : ERR;
+
+    m_capture = NULL;
+
+    return status;
+}
+
+bool npz_capture_active(void)
+{
+    return m_capture != NULL;
 }
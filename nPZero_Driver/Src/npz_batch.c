@@ -0,0 +1,180 @@
+/**
+ * @file npz_batch.c
+ * @brief Implementation of the batched reporting.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+/** Events that come with a value. */
+#define VALUE_EVENTS (NPZ_EVENT_PER_TRIGGER_ALL | NPZ_EVENT_ADC_INTERNAL | NPZ_EVENT_ADC_EXTERNAL)
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+static void to_sample(const npz_batch_s *batch, const npz_batch_record_s *record, npz_history_sample_s *sample)
+{
+    sample->timestamp = batch->base_seconds + record->offset_s;
+    sample->raw = record->raw;
+    sample->reason = (uint16_t)(1U << record->event);
+    sample->peripheral = (record->event < 4) ? record->event : NPZ_HISTORY_NO_PERIPHERAL;
+}
+
+static void append(npz_batch_s *batch, const npz_batch_policy_s *policy, uint8_t event, uint16_t raw,
+                   uint32_t timestamp)
+{
+    npz_batch_record_s *record;
+    npz_history_sample_s sample;
+
+    if (batch->count == 0)
+    {
+        batch->base_seconds = timestamp;
+    }
+    else if (batch->count == NPZ_BATCH_SIZE)
+    {
+        memmove(&batch->records[0], &batch->records[1], (NPZ_BATCH_SIZE - 1) * sizeof(batch->records[0]));
+        batch->count--;
+
+        if (batch->dropped < UINT8_MAX)
+        {
+            batch->dropped++;
+        }
+    }
+
+    record = &batch->records[batch->count++];
+    record->event = event;
+    record->raw = raw;
+
+    // Time is not expected to go back, but a restarted clock must not wrap the offset
+    if (timestamp < batch->base_seconds)
+    {
+        record->offset_s = 0;
+    }
+    else if (timestamp - batch->base_seconds > UINT16_MAX)
+    {
+        record->offset_s = UINT16_MAX;
+        batch->span_full = 1;
+    }
+    else
+    {
+        record->offset_s = (uint16_t)(timestamp - batch->base_seconds);
+    }
+
+    if (policy->is_urgent != NULL)
+    {
+        to_sample(batch, record, &sample);
+
+        if (policy->is_urgent(&sample))
+        {
+            batch->urgent = 1;
+        }
+    }
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_batch_clear(npz_batch_s *batch)
+{
+    memset(batch, 0, sizeof(*batch));
+}
+
+bool npz_batch_record_wake(npz_batch_s *batch, const npz_batch_policy_s *policy, const npz_wake_s *wake,
+                           uint32_t timestamp)
+{
+    uint16_t pending = wake->events & VALUE_EVENTS;
+
+    while (pending != 0)
+    {
+        uint8_t bit = (uint8_t)__builtin_ctz(pending);
+        pending &= pending - 1;
+
+        if ((1U << bit) == NPZ_EVENT_ADC_INTERNAL)
+        {
+            append(batch, policy, bit, wake->adc_core, timestamp);
+        }
+        else if ((1U << bit) == NPZ_EVENT_ADC_EXTERNAL)
+        {
+            append(batch, policy, bit, wake->adc_ext, timestamp);
+        }
+        else
+        {
+            append(batch, policy, bit, wake->valp[bit], timestamp);
+        }
+    }
+
+    if (wake->events & policy->urgent_events)
+    {
+        batch->urgent = 1;
+    }
+
+    if (batch->wakes < UINT8_MAX)
+    {
+        batch->wakes++;
+    }
+
+    return npz_batch_due(batch, policy);
+}
+
+bool npz_batch_due(const npz_batch_s *batch, const npz_batch_policy_s *policy)
+{
+    if (batch->urgent || batch->span_full || batch->count >= NPZ_BATCH_SIZE)
+    {
+        return true;
+    }
+
+    return (policy->flush_wakes != 0) && (batch->wakes >= policy->flush_wakes);
+}
+
+npz_status_e npz_batch_flush(npz_batch_s *batch, const npz_batch_sink_s *sink)
+{
+    npz_history_sample_s samples[NPZ_BATCH_SIZE];
+    bool written;
+
+    if (batch == NULL || sink == NULL || sink->write == NULL)
+    {
+        return INVALID_PARAM;
+    }
+
+    // Nothing to send is not worth powering the transmitter up
+    if (batch->count == 0)
+    {
+        npz_batch_clear(batch);
+        return OK;
+    }
+
+    if (sink->open != NULL && !sink->open(sink->context))
+    {
+        return ERR;
+    }
+
+    for (uint8_t i = 0; i < batch->count; i++)
+    {
+        to_sample(batch, &batch->records[i], &samples[i]);
+    }
+
+    written = sink->write(samples, batch->count, sink->context);
+
+    if (sink->close != NULL)
+    {
+        sink->close(sink->context);
+    }
+
+    if (!written)
+    {
+        return ERR;
+    }
+
+    npz_batch_clear(batch);
+
+    return OK;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file npz_cobs.c
+ * @brief Implementation of the COBS encoder and streaming decoder.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t npz_cobs_encode(const uint8_t *data, size_t length, uint8_t *encoded)
+{
+    size_t code_index = 0; // Where the length of the current block goes
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] != 0)
+        {
+            encoded[out++] = data[i];
+            code++;
+        }
+
+        // A zero ends the block, and so do 254 non-zero bytes in a row
+        if (data[i] == 0 || code == 0xFF)
+        {
+            encoded[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+    }
+
+    encoded[code_index] = code;
+
+    return out;
+}
+
+npz_cobs_result_e npz_cobs_decode_byte(npz_cobs_decoder_s *decoder, uint8_t in, uint8_t *out)
+{
+    bool zero;
+
+    if (in == NPZ_COBS_DELIMITER)
+    {
+        decoder->remaining = 0;
+        decoder->zero_pending = false;
+        return NPZ_COBS_END;
+    }
+
+    if (decoder->remaining != 0)
+    {
+        decoder->remaining--;
+        *out = in;
+        return NPZ_COBS_BYTE;
+    }
+
+    // A block length, the zero that ended the previous block is only real if another block follows
+    zero = decoder->zero_pending;
+    decoder->remaining = (uint8_t)(in - 1);
+    decoder->zero_pending = (in != 0xFF);
+
+    if (zero)
+    {
+        *out = 0;
+        return NPZ_COBS_BYTE;
+    }
+
+    return NPZ_COBS_NONE;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file npz_console.c
+ * @brief Implementation of the buffered console output.
+ *
+ * npz_hal_uart_write() sends one buffer at a time from the UART transmit interrupt and calls back when it is done.
+ * The callback copies the next chunk out of the ring into a small staging buffer and hands it to the HAL, so the
+ * ring only holds bytes that have not been sent yet and NPZ_CONSOLE_OVERWRITE can drop the oldest ones at any time.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define RING_MASK  (NPZ_CONSOLE_SIZE - 1)
+#define CHUNK_SIZE 16 /**< Bytes handed to the HAL per transfer. */
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+static uint8_t m_ring[NPZ_CONSOLE_SIZE];
+static uint8_t m_chunk[CHUNK_SIZE]; /**< Bytes being sent, read by the HAL from the interrupt. */
+static volatile uint16_t m_head;    /**< Free-running index of the next byte to write. */
+static volatile uint16_t m_tail;    /**< Free-running index of the next byte to send. */
+static uint16_t m_dropped;
+static npz_console_done_f m_done;   /**< Callback of the DMA transfer in progress. */
+static uintptr_t m_done_context;
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+static void send_next(void);
+
+/**
+ * @brief Completion of a chunk, called from the transmit interrupt.
+ */
+static void chunk_done(bool sent)
+{
+    send_next();
+}
+
+static void add_dropped(size_t count)
+{
+    m_dropped = (count >= (size_t)(UINT16_MAX - m_dropped)) ? UINT16_MAX : (uint16_t)(m_dropped + count);
+}
+
+/**
+ * @brief Hands the next chunk to the HAL.
+ */
+static void send_next(void)
+{
+    uint16_t count = (uint16_t)(m_head - m_tail);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (count > CHUNK_SIZE)
+    {
+        count = CHUNK_SIZE;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        m_chunk[i] = m_ring[(uint16_t)(m_tail + i) & RING_MASK];
+    }
+
+    m_tail += count;
+
+    npz_hal_uart_write(m_chunk, count, chunk_done);
+}
+
+/**
+ * @brief Completion of npz_console_send(), called from the transmit interrupt.
+ */
+static void send_done(bool sent)
+{
+    npz_console_done_f done = m_done;
+
+    m_done = NULL;
+
+    if (done != NULL)
+    {
+        done(sent, m_done_context);
+    }
+
+    // Output written during the transfer waited in the ring
+    send_next();
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+size_t npz_console_write(const void *data, size_t count)
+{
+    const uint8_t *bytes = data;
+    size_t accepted = count;
+    uint32_t state;
+    size_t space;
+
+    if (data == NULL || count == 0)
+    {
+        return 0;
+    }
+
+    state = npz_hal_uart_lock();
+    space = NPZ_CONSOLE_SIZE - (uint16_t)(m_head - m_tail);
+
+    if (NPZ_CONSOLE_POLICY == NPZ_CONSOLE_OVERWRITE)
+    {
+        // Only the last NPZ_CONSOLE_SIZE bytes can be kept, and older unsent output goes first
+        if (count > NPZ_CONSOLE_SIZE)
+        {
+            add_dropped(count - NPZ_CONSOLE_SIZE);
+            bytes += count - NPZ_CONSOLE_SIZE;
+            count = NPZ_CONSOLE_SIZE;
+        }
+
+        if (count > space)
+        {
+            add_dropped(count - space);
+            m_tail += (uint16_t)(count - space);
+        }
+    }
+    else if (count > space)
+    {
+        add_dropped(count - space);
+        count = space;
+        accepted = space;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_ring[(uint16_t)(m_head + i) & RING_MASK] = bytes[i];
+    }
+
+    m_head += (uint16_t)count;
+
+    npz_hal_uart_unlock(state);
+    npz_console_kick();
+
+    return accepted;
+}
+
+bool npz_console_send(const void *data, size_t size, npz_console_done_f done, uintptr_t context)
+{
+    bool started = false;
+    uint32_t state;
+
+    if (data == NULL || size == 0 || size > UINT16_MAX)
+    {
+        return false;
+    }
+
+    state = npz_hal_uart_lock();
+
+    // Ring output goes first, so the order of the output is kept
+    if (m_head == m_tail && !npz_hal_uart_is_busy())
+    {
+        m_done = done;
+        m_done_context = context;
+        started = npz_hal_uart_dma_write(data, (uint16_t)size, send_done);
+    }
+
+    npz_hal_uart_unlock(state);
+
+    return started;
+}
+
+void npz_console_kick(void)
+{
+    uint32_t state = npz_hal_uart_lock();
+
+    // While the HAL is busy, its completion callback picks up the new output
+    if (npz_hal_uart_is_on() && !npz_hal_uart_is_busy())
+    {
+        send_next();
+    }
+
+    npz_hal_uart_unlock(state);
+}
+
+bool npz_console_drain(uint32_t timeout)
+{
+    uint32_t start = npz_hal_get_ms();
+
+    npz_console_kick();
+
+    while (m_head != m_tail || !npz_hal_uart_is_sent())
+    {
+        if (!npz_hal_uart_is_on() || (npz_hal_get_ms() - start) > timeout)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t npz_console_free(void)
+{
+    return NPZ_CONSOLE_SIZE - (uint16_t)(m_head - m_tail);
+}
+
+uint16_t npz_console_dropped(void)
+{
+    return m_dropped;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file npz_convert.c
+ * @brief Implementation of the integer-only sensor value conversions.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+const npz_convert_s npz_convert_as6212_temperature = {
+    .scale_q16 = NPZ_CONVERT_SCALE_Q16(78125, 10000), // 7.8125 milli-degC per LSB
+    .offset_milli = 0,
+    .is_signed = true,
+};
+
+const npz_convert_s npz_convert_accel_2g = {
+    .scale_q16 = NPZ_CONVERT_SCALE_Q16(2000, 32768), // 2000 mg over 32768 LSB
+    .offset_milli = 0,
+    .is_signed = true,
+};
+
+static const uint16_t m_round_step[4] = {1000, 100, 10, 1}; /**< Step of the last kept decimal. */
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+int32_t npz_convert_milli(const npz_convert_s *conversion, uint16_t raw)
+{
+    int32_t value = conversion->is_signed ? (int32_t)(int16_t)raw : (int32_t)raw;
+
+    // 16x32 bit product fits in 48 bits, add one half before dropping the fraction
+    int64_t scaled = (int64_t)value * conversion->scale_q16 + (1 << 15);
+
+    return (int32_t)(scaled >> 16) + conversion->offset_milli;
+}
+
+size_t npz_convert_format(int32_t milli, uint8_t decimals, char *buffer, size_t size)
+{
+    char digits[12];
+    size_t count = 0;
+    size_t length = 0;
+    uint32_t magnitude;
+    uint16_t step;
+
+    if (buffer == NULL || size == 0)
+    {
+        return 0;
+    }
+
+    if (decimals > 3)
+    {
+        decimals = 3;
+    }
+
+    step = m_round_step[decimals];
+    magnitude = (milli < 0) ? (uint32_t)(-(int64_t)milli) : (uint32_t)milli;
+    magnitude = (magnitude + step / 2) / step; // In units of the last kept decimal
+
+    if (milli < 0 && magnitude != 0)
+    {
+        buffer[length++] = '-';
+    }
+
+    // Collect digits from the least significant one, at least one integer digit
+    do
+    {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0 || count <= decimals);
+
+    // Sign, digits, decimal point and terminator
+    if (length + count + (decimals ? 1 : 0) + 1 > size)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    while (count > 0)
+    {
+        if (count == decimals)
+        {
+            buffer[length++] = '.';
+        }
+
+        buffer[length++] = digits[--count];
+    }
+
+    buffer[length] = '\0';
+
+    return length;
+}
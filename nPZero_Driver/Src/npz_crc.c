@@ -0,0 +1,40 @@
+/**
+ * @file npz_crc.c
+ * @brief Implementation of the CRC-16/CCITT-FALSE.
+ *
+ * A 16-entry table processes four bits at a time, a trade-off between the eight shifts per byte of the bitwise form
+ * and the 512 bytes of flash of a full table.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+/** CRC of each 4-bit value shifted into the top of the register. */
+static const uint16_t m_crc16_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+uint16_t npz_crc16(uint16_t crc, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ m_crc16_nibble[(crc >> 12) ^ (bytes[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ m_crc16_nibble[(crc >> 12) ^ (bytes[i] & 0x0F)]);
+    }
+
+    return crc;
+}
@@ -19,29 +19,43 @@
 #define SRAM_START 0x80
 #define SRAM_SIZE  128
 
+/** SRAM left to init sequences, the tail belongs to npz_retained. */
+#define SRAM_SEQUENCE_SIZE (SRAM_SIZE - NPZ_RETAINED_SIZE)
+
+#define ADC_CODE_COUNT 64 /**< ADC_CORE and ADC_EXT are 6-bit codes. */
+
+/** Address of a per-peripheral register, given the peripheral 1 register and a zero-based index. */
+#define NPZ_PERIPHERAL_REG(reg_per1, index) ((uint8_t)((reg_per1) + (index) * (REG_CFGP2 - REG_CFGP1)))
+
 /*****************************************************************************
  * Data
  *****************************************************************************/
 
-static struct m_adc_ext_code_level_map
-{
-    uint8_t code;
-    uint16_t millivolts;
-}
-
-adc_ext_code_map[] = {{0x00, 600}, {0x08, 700}, {0x0F, 800}, {0x15, 900}, {0x19, 1000},
-    {0x1C, 1100}, {0x1F, 1200}, {0x22, 1300}, {0x23, 1400}, {0x24, 1500}, {0x26, 1600},
-    {0x28, 1700}, {0x29, 1800}, {0x2A, 1900}, {0x2B, 2000}, {0x2C, 2100}, {0x2D, 2200},
-    {0x2E, 2300}, {0x2F, 2400}, {0x30, 3600}, {0x31, 2700}, {0x32, 2900}, {0x33, 3100},
-    {0x34, 3400}};
-
-static struct m_adc_core_code_level_map
-{
-    uint8_t code;
-    uint16_t millivolts;
-} adc_core_code_map[] = {{0x24, 1500}, {0x26, 1600}, {0x28, 1700}, {0x29, 1800}, {0x2A, 1900},
-    {0x2B, 2000}, {0x2C, 2100}, {0x2D, 2200}, {0x2E, 2300}, {0x2F, 2400}, {0x30, 2600},
-    {0x31, 2800}, {0x32, 3000}, {0x33, 3200}, {0x34, 3400}};
+/*
+ * Millivolts for every ADC code. Codes listed in the datasheet level tables hold the datasheet value, codes in
+ * between are interpolated linearly, codes outside the listed range hold the nearest listed value.
+ */
+static const uint16_t m_adc_ext_mv[ADC_CODE_COUNT] = {
+     600,  613,  625,  638,  650,  663,  675,  688,  /* 0x00 */
+     700,  714,  729,  743,  757,  771,  786,  800,  /* 0x08 */
+     817,  833,  850,  867,  883,  900,  925,  950,  /* 0x10 */
+     975, 1000, 1033, 1067, 1100, 1133, 1167, 1200,  /* 0x18 */
+    1233, 1267, 1300, 1400, 1500, 1550, 1600, 1650,  /* 0x20 */
+    1700, 1800, 1900, 2000, 2100, 2200, 2300, 2400,  /* 0x28 */
+    2600, 2700, 2900, 3100, 3400, 3400, 3400, 3400,  /* 0x30 */
+    3400, 3400, 3400, 3400, 3400, 3400, 3400, 3400,  /* 0x38 */
+};
+
+static const uint16_t m_adc_core_mv[ADC_CODE_COUNT] = {
+    1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500,  /* 0x00 */
+    1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500,  /* 0x08 */
+    1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500,  /* 0x10 */
+    1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500,  /* 0x18 */
+    1500, 1500, 1500, 1500, 1500, 1550, 1600, 1650,  /* 0x20 */
+    1700, 1800, 1900, 2000, 2100, 2200, 2300, 2400,  /* 0x28 */
+    2600, 2800, 3000, 3200, 3400, 3400, 3400, 3400,  /* 0x30 */
+    3400, 3400, 3400, 3400, 3400, 3400, 3400, 3400,  /* 0x38 */
+};
 
 /** Struct that holds Internal ADC configuration including threshold values. */
 typedef struct
@@ -64,7 +78,6 @@ typedef struct
     npz_register_modp_s modp;   /**< Struct Peripheral Mode register. */
     npz_register_perp_s perp;   /**< Struct Peripheral Polling register. */
     npz_register_ncmdp_s ncmdp; /**< Struct Peripheral Number of Commands register. */
-    npz_register_sram_s sram_p;
     npz_register_addrp_s addrp;   /**< Struct Peripheral Address register. */
     npz_register_rregp_s rregp;   /**< Struct Peripheral Address of I2C register. */
     npz_register_throvp_s throvp; /**< Struct Peripheral Threshold Over Value. */
@@ -78,14 +91,51 @@ static int m_configured_indices[4] = {-1, -1, -1, -1}; /**< Initialize with inva
 static int m_configured_count = 0;                     /**< Count of configured peripherals. */
 static int m_sram_count = 0;                           /**< Count of Bytes writed to SRAM. */
 
+static npz_error_s m_last_error = {NPZ_ERROR_NONE, NPZ_ERROR_NO_REGISTER, NPZ_ERROR_NO_PERIPHERAL};
+
+/** MODP last written to each peripheral, all zero (UINT16) for peripherals that are not configured. */
+static npz_register_modp_s m_modp[4] = {0};
+
+/*
+ * Mask and sign bit of each data type, indexed by MODP dtype. Masking and then sign-extending with
+ * (value ^ sign) - sign decodes all types the same way, without branching on the type.
+ */
+static const struct
+{
+    uint16_t mask;
+    uint16_t sign;
+} m_dtype_decode[4] = {
+    [DATA_TYPE_UINT16] = {0xFFFF, 0x0000},
+    [DATA_TYPE_INT16] = {0xFFFF, 0x8000},
+    [DATA_TYPE_UINT8] = {0x00FF, 0x0000},
+    [3] = {0xFFFF, 0x0000}, // Reserved, read as UINT16
+};
+
 /*****************************************************************************
  * Private Methods
  *****************************************************************************/
 
+/**
+ * @brief Records the cause of a failure so it can be read back with npz_device_get_last_error().
+ *
+ * @return Always false, so error paths can return the result directly.
+ */
+static bool set_error(npz_error_cause_e cause, uint8_t reg, int peripheral)
+{
+    m_last_error.cause = cause;
+    m_last_error.reg = reg;
+    m_last_error.peripheral = (int8_t)peripheral;
+
+    NPZ_LOG_DEBUG("Error cause %d, register 0x%02X, peripheral %d\r\n", cause, reg, peripheral);
+    NPZ_ERROR_HOOK(&m_last_error);
+
+    return false;
+}
+
 /**
  * @brief Sets global time out until host wakes up.
  */
-static bool set_global_timeout(npz_device_config_s * device_config)
+static bool set_global_timeout(const npz_device_config_s * device_config)
 {
     npz_register_tout_s time_out_config = {0};
 
@@ -97,46 +147,40 @@ static bool set_global_timeout(npz_device_config_s * device_config)
 
         if (npz_write_TOUT(time_out_config) != OK)
         {
-            printf("Failed to write Timeout register\r\n");
-            return false;
+            return set_error(NPZ_ERROR_REGISTER_WRITE, REG_TOUT_L, NPZ_ERROR_NO_PERIPHERAL);
         }
     }
     else
     {
-        printf("Invalid global timeout\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_TOUT_L, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
 // Set Power Switch Control
-static bool set_power_switch_control(npz_device_config_s * device_config)
+static bool set_power_switch_control(const npz_device_config_s * device_config)
 {
     npz_register_pswctl_s pswctl = {0};
 
     if (device_config->power_switch_normal_mode_per1 > 1)
     {
-        printf("Invalid power switch mode for peripheral 1\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_PSWCTL, 0);
     }
 
     if (device_config->power_switch_normal_mode_per2 > 1)
     {
-        printf("Invalid power switch mode for peripheral 2\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_PSWCTL, 1);
     }
 
     if (device_config->power_switch_normal_mode_per3 > 1)
     {
-        printf("Invalid power switch mode for peripheral 3\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_PSWCTL, 2);
     }
 
     if (device_config->power_switch_normal_mode_per4 > 1)
     {
-        printf("Invalid power switch mode for peripheral 4\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_PSWCTL, 3);
     }
 
     switch (device_config->host_power_mode)
@@ -147,14 +191,12 @@ static bool set_power_switch_control(npz_device_config_s * device_config)
             // Valid mode, do nothing
             break;
         default:
-            printf("Invalid host power switch mode\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_PSWCTL, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     if (device_config->power_switch_gate_boost > 1)
     {
-        printf("Invalid gate boost value for power switches\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_PSWCTL, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     pswctl.pswint_p1 = device_config->power_switch_normal_mode_per1; // Peripheral 1
@@ -165,14 +207,13 @@ static bool set_power_switch_control(npz_device_config_s * device_config)
     pswctl.psw_en_vn = device_config->power_switch_gate_boost;
     if (npz_write_PSWCTL(pswctl) != OK)
     {
-        printf("Failed to write power control register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_PSWCTL, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
-static bool set_system_config1(npz_device_config_s * device_config)
+static bool set_system_config1(const npz_device_config_s * device_config)
 {
     npz_register_syscfg1_s syscfg1 = {0};
 
@@ -187,14 +228,13 @@ static bool set_system_config1(npz_device_config_s * device_config)
 
     if (npz_write_SYSCFG1(syscfg1) != OK)
     {
-        printf("Failed to write SYSCFG1 register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_SYSCFG1, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
-static bool set_system_config2(npz_device_config_s * device_config)
+static bool set_system_config2(const npz_device_config_s * device_config)
 {
     npz_register_syscfg2_s syscfg2 = {0};
 
@@ -221,8 +261,7 @@ static bool set_system_config2(npz_device_config_s * device_config)
             syscfg2.sclk_div_sel = 3;
             break;
         default:
-            printf("Invalid system clock divider value\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_SYSCFG2, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     syscfg2.sclk_sel = device_config->system_clock_source;
@@ -244,20 +283,18 @@ static bool set_system_config2(npz_device_config_s * device_config)
             syscfg2.adc_clk_sel = 3; // Enable ADC clock 1024 Hz
             break;
         default:
-            printf("Invalid adc clock divider value\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_SYSCFG2, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     if (npz_write_SYSCFG2(syscfg2) != OK)
     {
-        printf("Failed to write SYSCFG2 register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_SYSCFG2, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
-static bool set_system_config3(npz_device_config_s * device_config)
+static bool set_system_config3(const npz_device_config_s * device_config)
 {
     npz_register_syscfg3_s syscfg3 = {0};
 
@@ -272,13 +309,12 @@ static bool set_system_config3(npz_device_config_s * device_config)
 
     if (npz_write_SYSCFG3(syscfg3) != OK)
     {
-        printf("Failed to write SYSCFG3 register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_SYSCFG3, NPZ_ERROR_NO_PERIPHERAL);
     }
     return true;
 }
 
-static bool set_interrupt_pin_config(npz_device_config_s * device_config)
+static bool set_interrupt_pin_config(const npz_device_config_s * device_config)
 {
     npz_register_intcfg_s intcfg = {0};
 
@@ -297,8 +333,7 @@ static bool set_interrupt_pin_config(npz_device_config_s * device_config)
             intcfg.pu_s_int1 = INT_PIN_PULL_HIGH >> 1;
             break;
         default:
-            printf("Invalid interrupt pin 1 value\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_INTCFG, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     switch (device_config->interrupt_pin_pull_up_pin2)
@@ -316,8 +351,7 @@ static bool set_interrupt_pin_config(npz_device_config_s * device_config)
             intcfg.pu_s_int2 = INT_PIN_PULL_HIGH >> 1;
             break;
         default:
-            printf("Invalid interrupt pin 2 value\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_INTCFG, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     switch (device_config->interrupt_pin_pull_up_pin3)
@@ -335,8 +369,7 @@ static bool set_interrupt_pin_config(npz_device_config_s * device_config)
             intcfg.pu_s_int3 = INT_PIN_PULL_HIGH >> 1;
             break;
         default:
-            printf("Invalid interrupt pin 3 value\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_INTCFG, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     switch (device_config->interrupt_pin_pull_up_pin4)
@@ -354,20 +387,18 @@ static bool set_interrupt_pin_config(npz_device_config_s * device_config)
             intcfg.pu_s_int4 = INT_PIN_PULL_HIGH >> 1;
             break;
         default:
-            printf("Invalid interrupt pin 4 value\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, REG_INTCFG, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     if (npz_write_INTCFG(intcfg) != OK)
     {
-        printf("Failed to write INTCFG register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_INTCFG, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
-static bool set_peripheral_power_mode(npz_device_config_s * device_config,
+static bool set_peripheral_power_mode(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     peripheral[index].cfgp.pwmod = device_config->peripherals[index]->power_mode;
@@ -376,40 +407,56 @@ static bool set_peripheral_power_mode(npz_device_config_s * device_config,
     peripheral[index].cfgp.intmod = device_config->peripherals[index]->interrupt_pin_mode;
     if (npz_write_CFGP(switch_id, peripheral[index].cfgp) != OK)
     {
-        printf("Failed to write CFGP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_CFGP1, index), index);
     }
 
     return true;
 }
 
-static bool set_peripheral_mode(npz_device_config_s * device_config,
-    peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
+/**
+ * @brief Builds the MODP register of a peripheral configuration.
+ */
+static npz_register_modp_s peripheral_modp(const npz_peripheral_config_s * config)
 {
-    peripheral[index].modp.cmod = device_config->peripherals[index]->comparison_mode;
-    peripheral[index].modp.dtype = device_config->peripherals[index]->sensor_data_type;
-    peripheral[index].modp.seqrw = device_config->peripherals[index]->multi_byte_transfer_enable;
+    npz_register_modp_s modp = {0};
 
-    if (device_config->peripherals[index]->communication_protocol == COM_I2C)
+    modp.cmod = config->comparison_mode;
+    modp.dtype = config->sensor_data_type;
+    modp.seqrw = config->multi_byte_transfer_enable;
+
+    if (NPZ_CFG_PROTOCOL(config) == COM_I2C)
     {
-        peripheral[index].modp.wunak = device_config->peripherals[index]->i2c_cfg.wake_on_nak;
+        modp.wunak = config->i2c_cfg.wake_on_nak;
     }
-    else if (device_config->peripherals[index]->communication_protocol == COM_SPI)
+    else if (NPZ_CFG_PROTOCOL(config) == COM_SPI)
     {
-        peripheral[index].modp.spimod = device_config->peripherals[index]->spi_cfg.mode;
+        modp.spimod = config->spi_cfg.mode;
     }
 
-    peripheral[index].modp.swprreg = device_config->peripherals[index]->swap_registers;
+    modp.swprreg = config->swap_registers;
+
+    return modp;
+}
+
+static bool set_peripheral_mode(const npz_device_config_s * device_config,
+    peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
+{
+    peripheral[index].modp = peripheral_modp(device_config->peripherals[index]);
     if (npz_write_MODP(switch_id, peripheral[index].modp) != OK)
     {
-        printf("Failed to write MODP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_MODP1, index), index);
+    }
+
+    // A captured configuration is not the one the device decodes its values with
+    if (!npz_capture_active())
+    {
+        m_modp[index] = peripheral[index].modp;
     }
 
     return true;
 }
 
-static bool set_peripheral_polling_period(npz_device_config_s * device_config,
+static bool set_peripheral_polling_period(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     peripheral[index].perp.perp_l =
@@ -419,166 +466,128 @@ static bool set_peripheral_polling_period(npz_device_config_s * device_config,
 
     if (npz_write_PERP(switch_id, peripheral[index].perp) != OK)
     {
-        printf("Failed to write PERP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_PERP1_L, index), index);
     }
 
     return true;
 }
 
-static bool set_peripheral_init_cmds_number(npz_device_config_s * device_config,
-    peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
+/**
+ * @brief Streams a byte sequence into the next free SRAM locations.
+ *
+ * The sequence is read in place, so it can live in flash together with the rest of a const configuration.
+ */
+static bool write_sram_sequence(const uint8_t * bytes, uint8_t length, int index)
 {
-    uint8_t SRAM_number_bytes_2_write = 0;
+    if (length == 0)
+    {
+        return true;
+    }
 
-    if (device_config->peripherals[index]->communication_protocol == COM_I2C)
+    if (bytes == NULL)
     {
-        peripheral[index].ncmdp.ncmdp = device_config->peripherals[index]->i2c_cfg.command_num;
+        return set_error(NPZ_ERROR_NULL_CONFIG, NPZ_PERIPHERAL_REG(REG_NCMDP1, index), index);
+    }
 
-        if (m_sram_count <= SRAM_SIZE)
-        {
-        	SRAM_number_bytes_2_write = device_config->peripherals[index]->i2c_cfg.command_num * 2;
+    if (m_sram_count + length > SRAM_SEQUENCE_SIZE)
+    {
+        return set_error(NPZ_ERROR_SRAM_FULL, SRAM_START + m_sram_count, index);
+    }
 
-            for (uint8_t i = 0; i < SRAM_number_bytes_2_write; i++)
-            {
-                if (npz_write_SRAM(SRAM_START + m_sram_count,
-                        device_config->peripherals[index]->i2c_cfg.bytes_from_sram[i]) != OK)
-                {
-                    printf("Failed to write SRAM Value for peripheral %d", index + 1);
-                    return false;
-                }
-                else
-                {
-//                    printf(
-//                        "BYTE write SRAM Value for peripheral %d value [%02x] SRAM Addr [%02x] \n\r",
-//                        index + 1,
-//                        device_config->peripherals[index]->i2c_cfg.bytes_from_sram[i],
-//                        SRAM_START + m_sram_count);
-                    m_sram_count++;
-                }
-            }
-        }
-        else
+    for (uint8_t i = 0; i < length; i++)
+    {
+        if (npz_write_SRAM(SRAM_START + m_sram_count, bytes[i]) != OK)
         {
-            printf("No SRAM space available for peripheral %d \n\r", index + 1);
+            return set_error(NPZ_ERROR_REGISTER_WRITE, SRAM_START + m_sram_count, index);
         }
+
+        m_sram_count++;
     }
-    else if (device_config->peripherals[index]->communication_protocol == COM_SPI)
-    {
-    	peripheral[index].ncmdp.ncmdp = device_config->peripherals[index]->spi_cfg.bytes_from_sram_num;
 
-    	if (m_sram_count <= SRAM_SIZE)
-        {
-        	SRAM_number_bytes_2_write = device_config->peripherals[index]->i2c_cfg.command_num;
+    return true;
+}
 
-            for (uint8_t i = 0; i < SRAM_number_bytes_2_write; i++)
-            {
-                if (npz_write_SRAM(SRAM_START + m_sram_count,
-                        device_config->peripherals[index]->spi_cfg.bytes_from_sram[i]) != OK)
-                {
-                    printf("Failed to write SRAM Value for peripheral %d", index + 1);
-                    return false;
-                }
-                else
-                {
-//                    printf(
-//                        "BYTE write SRAM Value for peripheral %d value [%02x] SRAM Addr [%02x] \n\r",
-//                        index + 1,
-//                        device_config->peripherals[index]->spi_cfg.bytes_from_sram[i],
-//                        SRAM_START + m_sram_count);
-                    m_sram_count++;
-                }
-            }
-        }
-        else
+static bool set_peripheral_init_cmds_number(const npz_device_config_s * device_config,
+    peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
+{
+    const npz_peripheral_config_s * config = device_config->peripherals[index];
+
+    if (NPZ_CFG_PROTOCOL(config) == COM_I2C)
+    {
+        peripheral[index].ncmdp.ncmdp = config->i2c_cfg.command_num;
+
+        // Each I2C command is an address byte followed by a value byte
+        if (!write_sram_sequence(config->i2c_cfg.bytes_from_sram, config->i2c_cfg.command_num * 2, index))
         {
-            printf("No SRAM space available for peripheral %d \n\r", index + 1);
+            return false;
         }
+    }
+    else if (NPZ_CFG_PROTOCOL(config) == COM_SPI)
+    {
+        peripheral[index].ncmdp.ncmdp = config->spi_cfg.bytes_from_sram_num;
 
-        if (device_config->peripherals[index]->spi_cfg.bytes_from_sram_read_num > 0)
+        if (!write_sram_sequence(config->spi_cfg.bytes_from_sram, config->spi_cfg.bytes_from_sram_num, index))
         {
-        	SRAM_number_bytes_2_write = device_config->peripherals[index]->spi_cfg.bytes_from_sram_read_num;
-            for (uint8_t i = 0; i < SRAM_number_bytes_2_write; i++)
-             {
-                 if (npz_write_SRAM(SRAM_START + m_sram_count,
-                         device_config->peripherals[index]->spi_cfg.bytes_from_sram_read[i]) != OK)
-                 {
-                     printf("Failed to write SRAM Value for peripheral %d", index + 1);
-                     return false;
-                 }
-                 else
-                 {
-//                     printf(
-//                         "BYTE write SRAM Value for peripheral %d value [%02x] SRAM Addr [%02x] \n\r",
-//                         index + 1,
-//                         device_config->peripherals[index]->spi_cfg.bytes_from_sram_read[i],
-//                         SRAM_START + m_sram_count);
-                     m_sram_count++;
-                 }
-             }
-
+            return false;
         }
-        else
+
+        if (!write_sram_sequence(
+                config->spi_cfg.bytes_from_sram_read, config->spi_cfg.bytes_from_sram_read_num, index))
         {
-            printf("No SRAM space available for peripheral %d \n\r", index + 1);
+            return false;
         }
-
-
     }
 
     if (npz_write_NCMDP(switch_id, peripheral[index].ncmdp) != OK)
     {
-        printf("Failed to write NCMDP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_NCMDP1, index), index);
     }
 
     return true;
 }
 
-static bool set_peripheral_address(npz_device_config_s * device_config,
+static bool set_peripheral_address(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
-    if (device_config->peripherals[index]->communication_protocol == COM_I2C)
+    if (NPZ_CFG_PROTOCOL(device_config->peripherals[index]) == COM_I2C)
     {
         peripheral[index].addrp.addrp =
             device_config->peripherals[index]->i2c_cfg.sensor_address;
     }
-    else if (device_config->peripherals[index]->communication_protocol == COM_SPI)
+    else if (NPZ_CFG_PROTOCOL(device_config->peripherals[index]) == COM_SPI)
     {
         peripheral[index].addrp.addrp =
             device_config->peripherals[index]->spi_cfg.bytes_from_sram_read_num;
     }
 
-    peripheral[index].addrp.spi_en = device_config->peripherals[index]->communication_protocol;
+    peripheral[index].addrp.spi_en = NPZ_CFG_PROTOCOL(device_config->peripherals[index]);
     if (npz_write_ADDRP(switch_id, peripheral[index].addrp) != OK)
     {
-        printf("Failed to write ADDRP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_ADDRP1, index), index);
     }
 
     return true;
 }
 
 // Set I2C Read Register for Peripheral
-static bool set_peripheral_i2c_read_register(npz_device_config_s * device_config,
+static bool set_peripheral_i2c_read_register(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     if (device_config->peripherals[index] != NULL &&
-        device_config->peripherals[index]->communication_protocol == COM_I2C)
+        NPZ_CFG_PROTOCOL(device_config->peripherals[index]) == COM_I2C)
     {
         peripheral[index].rregp.rregp =
             device_config->peripherals[index]->i2c_cfg.reg_address_value;
         if (npz_write_RREGP(switch_id, peripheral[index].rregp) != OK)
         {
-            printf("Failed to write RREGP register for peripheral %d\r\n", index + 1);
-            return false;
+            return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_RREGP1, index), index);
         }
     }
 
     return true;
 }
 
-static bool set_peripheral_under_threshold(npz_device_config_s * device_config,
+static bool set_peripheral_under_threshold(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     peripheral[index].thrunp.thrunp_l =
@@ -588,14 +597,13 @@ static bool set_peripheral_under_threshold(npz_device_config_s * device_config,
 
     if (npz_write_THRUNP(switch_id, peripheral[index].thrunp) != OK)
     {
-        printf("Failed to write THRUNP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_THRUNP1_L, index), index);
     }
 
     return true;
 }
 
-static bool set_peripheral_over_threshold(npz_device_config_s * device_config,
+static bool set_peripheral_over_threshold(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     peripheral[index].throvp.throvp_l =
@@ -604,14 +612,13 @@ static bool set_peripheral_over_threshold(npz_device_config_s * device_config,
         (uint8_t)((device_config->peripherals[index]->threshold_over >> 8) & 0xFF);
     if (npz_write_THROVP(switch_id, peripheral[index].throvp) != OK)
     {
-        printf("Failed to write THROVP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_THROVP1_L, index), index);
     }
 
     return true;
 }
 
-static bool set_peripheral_time_to_wait_config(npz_device_config_s * device_config,
+static bool set_peripheral_time_to_wait_config(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     switch (device_config->peripherals[index]->pre_wait_time)
@@ -629,8 +636,7 @@ static bool set_peripheral_time_to_wait_config(npz_device_config_s * device_conf
             peripheral[index].tcfgp.twt_ext = PRE_WAIT_TIME_EXTEND_4096 >> 1;
             break;
         default:
-            printf("Invalid pre-initialization wait time\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, NPZ_PERIPHERAL_REG(REG_TCFGP1, index), index);
     }
 
     switch (device_config->peripherals[index]->post_wait_time)
@@ -648,11 +654,10 @@ static bool set_peripheral_time_to_wait_config(npz_device_config_s * device_conf
             peripheral[index].tcfgp.tinit_ext = 1;
             break;
         default:
-            printf("Invalid post-initialization wait time\r\n");
-            return false;
+            return set_error(NPZ_ERROR_INVALID_PARAM, NPZ_PERIPHERAL_REG(REG_TCFGP1, index), index);
     }
 
-    if (device_config->peripherals[index]->communication_protocol == COM_I2C)
+    if (NPZ_CFG_PROTOCOL(device_config->peripherals[index]) == COM_I2C)
     {
         peripheral[index].tcfgp.i2cret =
             device_config->peripherals[index]->i2c_cfg.num_of_retries_on_nak;
@@ -660,48 +665,72 @@ static bool set_peripheral_time_to_wait_config(npz_device_config_s * device_conf
 
     if (npz_write_TCFGP(switch_id, peripheral[index].tcfgp) != OK)
     {
-        printf("Failed to write TCFGP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_TCFGP1, index), index);
     }
 
     return true;
 }
 
-static bool set_peripheral_time_to_wait(npz_device_config_s * device_config,
+static bool set_peripheral_time_to_wait(const npz_device_config_s * device_config,
     peripheral_config_s * peripheral, int index, npz_psw_e switch_id)
 {
     peripheral[index].twtp.twtp = device_config->peripherals[index]->time_to_wait;
     if (npz_write_TWTP(switch_id, peripheral[index].twtp) != OK)
     {
-        printf("Failed to write TWTP register for peripheral %d\r\n", index + 1);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, NPZ_PERIPHERAL_REG(REG_TWTP1, index), index);
     }
 
     return true;
 }
 
-static bool validate_peripherals(npz_device_config_s * device_config)
+static bool validate_peripherals(const npz_device_config_s * device_config)
 {
     m_configured_count = 0; // Reset count for each validation
 
     for (int i = 0; i < 4; i++)
     {
+        const npz_peripheral_config_s * config = device_config->peripherals[i];
+
         // Check if peripheral configuration is not NULL
-        if (device_config->peripherals[i] != NULL)
+        if (config == NULL)
         {
-            m_configured_indices[m_configured_count++] = i; // Store index of configured peripheral
+            continue;
         }
+
+        // Reject settings whose code paths were left out of the build (see npz_config.h)
+        if (!NPZ_CFG_PERIPHERAL_ENABLED(i))
+        {
+            return set_error(NPZ_ERROR_NOT_IN_BUILD, NPZ_ERROR_NO_REGISTER, i);
+        }
+
+        if (!NPZ_CFG_PROTOCOL_ENABLED(config->communication_protocol))
+        {
+            return set_error(NPZ_ERROR_NOT_IN_BUILD, NPZ_PERIPHERAL_REG(REG_ADDRP1, i), i);
+        }
+
+        if (!NPZ_CFG_POLLING_MODE_ENABLED(config->polling_mode))
+        {
+            return set_error(NPZ_ERROR_NOT_IN_BUILD, NPZ_PERIPHERAL_REG(REG_CFGP1, i), i);
+        }
+
+        m_configured_indices[m_configured_count++] = i; // Store index of configured peripheral
     }
 
     return true;
 }
 
-static bool configure_peripherals(npz_device_config_s * device_config)
+static bool configure_peripherals(const npz_device_config_s * device_config)
 {
     peripheral_config_s peripherals[4] = {0};
     npz_psw_e switches[4] = {
         PSW_LP1, PSW_LP2, PSW_LP3, PSW_LP4}; // Array to hold corresponding low power switch enums
 
+    // Peripherals left out of this configuration decode as UINT16 again
+    if (!npz_capture_active())
+    {
+        memset(m_modp, 0, sizeof(m_modp));
+    }
+
     // Iterate through the peripherals only if they are not NULL
     for (int j = 0; j < m_configured_count; j++)
     {
@@ -710,72 +739,53 @@ static bool configure_peripherals(npz_device_config_s * device_config)
         // Set power mode for peripheral configuration (CFGP)
         if (!set_peripheral_power_mode(device_config, peripherals, i, switches[i]))
         {
-            printf("Failed to set peripheral config for peripheral %d\r\n", i + 1);
             return false;
         }
 
         // Set mode for Peripheral (MODP)
         if (!set_peripheral_mode(device_config, peripherals, i, switches[i]))
         {
-            printf("Failed to set peripheral mode for peripheral %d\r\n", i + 1);
             return false;
         }
 
         // Set Polling Period for a Peripheral (PERP)
         if (!set_peripheral_polling_period(device_config, peripherals, i, switches[i]))
         {
-            printf("Failed to set peripheral polling period for peripheral %d\r\n", i + 1);
             return false;
         }
 
         // Set Number of init Commands for Peripheral (NCMDP)
         if (!set_peripheral_init_cmds_number(device_config, peripherals, i, switches[i]))
         {
-            printf(
-                "Failed to set peripheral init commands number for peripheral %d\r\n", i + 1);
             return false;
         }
 
-        if ((device_config->peripherals[i]->polling_mode ==
-                POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD) ||
-            (device_config->peripherals[i]->polling_mode ==
-                POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD) ||
-            (device_config->peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_WAIT_INTERRUPT))
+        if (NPZ_CFG_POLLING_HAS_ADDRESS(device_config->peripherals[i]->polling_mode))
         {
             // Set Address for a Peripheral (ADDRP)
             if (!set_peripheral_address(device_config, peripherals, i, switches[i]))
             {
-                printf("Failed to set peripheral address for peripheral %d\r\n", i + 1);
                 return false;
             }
         }
 
-        if ((device_config->peripherals[i]->polling_mode ==
-                POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD) ||
-            (device_config->peripherals[i]->polling_mode ==
-                POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD))
+        if (NPZ_CFG_POLLING_HAS_THRESHOLD(device_config->peripherals[i]->polling_mode))
         {
             // Set I2C Read Register for Peripheral (RREGP)
             if (!set_peripheral_i2c_read_register(device_config, peripherals, i, switches[i]))
             {
-                printf(
-                    "Failed to set peripheral I2C read register for peripheral %d\r\n", i + 1);
                 return false;
             }
 
             // Set Under Threshold for a Peripheral (THRUNP)
             if (!set_peripheral_under_threshold(device_config, peripherals, i, switches[i]))
             {
-                printf(
-                    "Failed to set peripheral under threshold for peripheral %d\r\n", i + 1);
                 return false;
             }
 
             // Set Over Threshold for a Peripheral (THROVP)
             if (!set_peripheral_over_threshold(device_config, peripherals, i, switches[i]))
             {
-                printf(
-                    "Failed to set peripheral over threshold for peripheral %d\r\n", i + 1);
                 return false;
             }
         }
@@ -783,15 +793,12 @@ static bool configure_peripherals(npz_device_config_s * device_config)
         // Set time to Wait for Peripheral (TWTP)
         if (!set_peripheral_time_to_wait(device_config, peripherals, i, switches[i]))
         {
-            printf("Failed to set peripheral time to wait for peripheral %d\r\n", i + 1);
             return false;
         }
 
         // Set Time to Wait Config for Peripheral (TCFGP)
         if (!set_peripheral_time_to_wait_config(device_config, peripherals, i, switches[i]))
         {
-            printf(
-                "Failed to set peripheral time to wait config for peripheral %d\r\n", i + 1);
             return false;
         }
     }
@@ -799,111 +806,97 @@ static bool configure_peripherals(npz_device_config_s * device_config)
     return true;
 }
 
-static bool configure_internal_adc(npz_device_config_s * device_config)
+static bool configure_internal_adc(const npz_device_config_s * device_config)
 {
     int_adc_channel_config_s adc_channel = {0};
 
-    if (device_config->adc_channels[0]->over_threshold > 0 &&
-        device_config->adc_channels[0]->under_threshold > 0)
+    // Both thresholds must be set, zero is taken as missing
+    if (device_config->adc_channels[0]->over_threshold == 0 ||
+        device_config->adc_channels[0]->under_threshold == 0)
     {
-        // Set Internal ADC over threshold Value
-        adc_channel.throva1.throva = device_config->adc_channels[0]->over_threshold;
-        if (npz_write_THROVA1(adc_channel.throva1) != OK)
-        {
-            printf("Failed to write THROVA1 register for internal ADC\r\n");
-            return false;
-        }
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_THROVA1, NPZ_ERROR_NO_PERIPHERAL);
+    }
 
-        // Set Internal ADC under threshold value
-        adc_channel.thruna1.thruna = device_config->adc_channels[0]->under_threshold;
-        if (npz_write_THRUNA1(adc_channel.thruna1) != OK)
-        {
-            printf("Failed to write THRUNA1 register for internal ADC\r\n");
-            return false;
-        }
+    // Set Internal ADC over threshold Value
+    adc_channel.throva1.throva = device_config->adc_channels[0]->over_threshold;
+    if (npz_write_THROVA1(adc_channel.throva1) != OK)
+    {
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_THROVA1, NPZ_ERROR_NO_PERIPHERAL);
     }
-    else
+
+    // Set Internal ADC under threshold value
+    adc_channel.thruna1.thruna = device_config->adc_channels[0]->under_threshold;
+    if (npz_write_THRUNA1(adc_channel.thruna1) != OK)
     {
-        printf("Failed to configure internal ADC\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_THRUNA1, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
-static bool configure_external_adc(npz_device_config_s * device_config)
+static bool configure_external_adc(const npz_device_config_s * device_config)
 {
     ext_adc_channel_config_s adc_channel = {0};
 
-    if (device_config->adc_channels[1]->over_threshold > 0 &&
-        device_config->adc_channels[1]->under_threshold > 0)
+    // Both thresholds must be set, zero is taken as missing
+    if (device_config->adc_channels[1]->over_threshold == 0 ||
+        device_config->adc_channels[1]->under_threshold == 0)
     {
-        // Set External ADC over threshold Value
-        adc_channel.throva2.throva = device_config->adc_channels[1]->over_threshold;
-        if (npz_write_THROVA2(adc_channel.throva2) != OK)
-        {
-            printf("Failed to write THROVA2 register for external ADC\r\n");
-            return false;
-        }
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_THROVA2, NPZ_ERROR_NO_PERIPHERAL);
+    }
 
-        // Set External ADC under threshold value
-        adc_channel.thruna2.thruna = device_config->adc_channels[1]->under_threshold;
-        if (npz_write_THRUNA2(adc_channel.thruna2) != OK)
-        {
-            printf("Failed to write THRUNA2 register for external ADC\r\n");
-            return false;
-        }
+    // Set External ADC over threshold Value
+    adc_channel.throva2.throva = device_config->adc_channels[1]->over_threshold;
+    if (npz_write_THROVA2(adc_channel.throva2) != OK)
+    {
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_THROVA2, NPZ_ERROR_NO_PERIPHERAL);
     }
-    else
+
+    // Set External ADC under threshold value
+    adc_channel.thruna2.thruna = device_config->adc_channels[1]->under_threshold;
+    if (npz_write_THRUNA2(adc_channel.thruna2) != OK)
     {
-        printf("Failed to configure external ADC\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_THRUNA2, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     return true;
 }
 
-static bool configure_global_settings(npz_device_config_s * device_config)
+static bool configure_global_settings(const npz_device_config_s * device_config)
 {
     // Set global time out
     if (!set_global_timeout(device_config))
     {
-        printf("Failed to set global timeout\r\n");
         return false;
     }
 
     // Set System Config 1
     if (!set_system_config1(device_config))
     {
-        printf("Failed to set system config 1\r\n");
         return false;
     }
 
     // Set System Config 2
     if (!set_system_config2(device_config))
     {
-        printf("Failed to set system config 2\r\n");
         return false;
     }
 
     // Set System Config 3
     if (!set_system_config3(device_config))
     {
-        printf("Failed to set system config 3\r\n");
         return false;
     }
 
     // Set power switch control
     if (!set_power_switch_control(device_config))
     {
-        printf("Failed to set power switch control\r\n");
         return false;
     }
 
     // Set Interrupt Pin's Configuration
     if (!set_interrupt_pin_config(device_config))
     {
-        printf("Failed to set interrupt pin's configuration\r\n");
         return false;
     }
 
@@ -911,247 +904,260 @@ static bool configure_global_settings(npz_device_config_s * device_config)
     return true;
 }
 
-static bool adc_ext_code_to_voltage(uint8_t code)
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_error_s npz_device_get_last_error(void)
 {
-    int n;
-    bool code_found = false;
-    int n_max = sizeof(adc_ext_code_map) / sizeof(struct m_adc_ext_code_level_map);
+    return m_last_error;
+}
+
+void npz_device_set_modes(const npz_device_config_s *device_config)
+{
+    memset(m_modp, 0, sizeof(m_modp));
 
-    for (n = 0; n < n_max; n++)
+    if (device_config == NULL)
     {
-        if (adc_ext_code_map[n].code == code)
-        {
-            printf("Reading value from adc channel is 0x%02X corresponds to an input voltage "
-                         "of %d.%03d V \r\n",
-                code, adc_ext_code_map[n].millivolts / 1000, adc_ext_code_map[n].millivolts % 1000);
-            code_found = true;
-            break;
-        }
+        return;
     }
 
-    if (!code_found)
+    for (int i = 0; i < 4; i++)
     {
-        printf("ADC reading value 0x%02X does not match any expected code \r\n", code);
-        return false;
+        if (device_config->peripherals[i] != NULL)
+        {
+            m_modp[i] = peripheral_modp(device_config->peripherals[i]);
+        }
     }
+}
 
-    return true;
+npz_register_modp_s npz_device_get_mode(int index)
+{
+    npz_register_modp_s none = {0};
+
+    return (index >= 0 && index < 4) ? m_modp[index] : none;
 }
 
-static bool adc_core_code_to_voltage(uint8_t code)
+int32_t npz_device_decode_value(npz_register_modp_s modp, uint8_t valp_l, uint8_t valp_h)
 {
-    int n;
-    bool code_found = false;
-    int n_max = sizeof(adc_core_code_map) / sizeof(struct m_adc_core_code_level_map);
+    // The device has applied swprreg when it stored the value, VALPn_H is the high byte for every endianness
+    uint16_t value = (uint16_t)((valp_h << 8) | valp_l) & m_dtype_decode[modp.dtype].mask;
+    int32_t sign = m_dtype_decode[modp.dtype].sign;
 
-    for (n = 0; n < n_max; n++)
-    {
-        if (adc_core_code_map[n].code == code)
-        {
-            printf("Reading value from adc channel is 0x%02X corresponds to an input voltage "
-                         "of %d.%03d V \r\n",
-                code, adc_core_code_map[n].millivolts / 1000,
-                adc_core_code_map[n].millivolts % 1000);
-            code_found = true;
-            break;
-        }
-    }
+    return (int32_t)(value ^ sign) - sign;
+}
 
-    if (!code_found)
+void npz_device_decode_values(const uint8_t snapshot[8], int32_t values[4])
+{
+    for (int i = 0; i < 4; i++)
     {
-        printf("ADC reading value 0x%02X does not match any expected code \r\n", code);
-        return false;
+        values[i] = npz_device_decode_value(m_modp[i], snapshot[2 * i], snapshot[2 * i + 1]);
     }
-
-    return true;
 }
 
+uint16_t npz_adc_core_mv(uint8_t code)
+{
+    return m_adc_core_mv[code & (ADC_CODE_COUNT - 1)];
+}
 
-/*****************************************************************************
- * Public Methods
- *****************************************************************************/
+uint16_t npz_adc_ext_mv(uint8_t code)
+{
+    return m_adc_ext_mv[code & (ADC_CODE_COUNT - 1)];
+}
 
-bool npz_device_handle_adc_external(void)
+bool npz_device_handle_adc_external(uint16_t * millivolts)
 {
     npz_register_adc_ext_s get_adc_ext_val = {0};
     npz_register_syscfg1_s syscfg1 = {0};
     npz_register_syscfg2_s syscfg2 = {0};
 
-    if (npz_read_SYSCFG1(&syscfg1) != OK)
+    if (millivolts == NULL)
     {
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_ADC_EXT, NPZ_ERROR_NO_PERIPHERAL);
+    }
 
-        printf("Failed to read SYSCFG1 register\r\n");
-        return false;
+    *millivolts = 0;
+
+    if (npz_read_SYSCFG1(&syscfg1) != OK)
+    {
+        return set_error(NPZ_ERROR_REGISTER_READ, REG_SYSCFG1, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     if (npz_read_SYSCFG2(&syscfg2) != OK)
     {
-
-        printf("Failed to read SYSCFG2 register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_READ, REG_SYSCFG2, NPZ_ERROR_NO_PERIPHERAL);
     }
 
     if (syscfg2.adc_ext_on == 1 && syscfg1.adc_ext_wakeup_enable == 1)
     {
         if (npz_read_ADC_EXT(&get_adc_ext_val) != OK)
         {
-            printf("Failed to read ADC_EXT register\r\n");
-            return false;
+            return set_error(NPZ_ERROR_REGISTER_READ, REG_ADC_EXT, NPZ_ERROR_NO_PERIPHERAL);
         }
 
+        // 0x1F is what the channel reads when nothing drives ADC_IN
         if (get_adc_ext_val.adc_ext == 0x1F)
         {
-            printf("ADC_IN analog pin not connected. Please connect the pin.\r\n");
-        }
-        else
-        {
-            printf("External ADC channel (connected to ADC_IN) was triggered\r\n");
-            bool adc_ext = adc_ext_code_to_voltage(get_adc_ext_val.adc_ext);
-            if (!adc_ext)
-            {
-                return false;
-            }
+            return set_error(NPZ_ERROR_ADC_NOT_CONNECTED, REG_ADC_EXT, NPZ_ERROR_NO_PERIPHERAL);
         }
+
+        NPZ_LOG_DEBUG("External ADC channel (connected to ADC_IN) read code 0x%02X\r\n", get_adc_ext_val.adc_ext);
+
+        *millivolts = npz_adc_ext_mv(get_adc_ext_val.adc_ext);
     }
 
     return true;
 }
 
-bool npz_device_handle_adc_internal(void)
+bool npz_device_handle_adc_internal(uint16_t * millivolts)
 {
     npz_register_adc_core_s get_adc_core_val = {0};
 
-    printf("Internal ADC channel (connected to VBAT) was triggered\r\n");
-    if (npz_read_ADC_CORE(&get_adc_core_val) != OK)
+    if (millivolts == NULL)
     {
-        printf("Failed to read ADC_CORE register\r\n");
-        return false;
+        return set_error(NPZ_ERROR_INVALID_PARAM, REG_ADC_CORE, NPZ_ERROR_NO_PERIPHERAL);
     }
 
-    bool adc_core = adc_core_code_to_voltage(get_adc_core_val.adc_core);
-    if (!adc_core)
+    *millivolts = 0;
+
+    if (npz_read_ADC_CORE(&get_adc_core_val) != OK)
     {
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_READ, REG_ADC_CORE, NPZ_ERROR_NO_PERIPHERAL);
     }
 
+    NPZ_LOG_DEBUG("Internal ADC channel (connected to VBAT) read code 0x%02X\r\n", get_adc_core_val.adc_core);
+
+    *millivolts = npz_adc_core_mv(get_adc_core_val.adc_core);
+
     return true;
 }
 
-
 bool npz_device_read_peripheral_value(npz_psw_e psw_lp, int index, int * peripheral_value)
 {
     npz_register_cfgp_s cfgp = {0};
     npz_register_valp_s valp = {0};
-    npz_register_addrp_s addrp = {0};
 
-    printf("External Trigger from Peripheral %d\r\n", psw_lp);
+    if (index < 0 || index >= 4 || peripheral_value == NULL)
+    {
+        return set_error(NPZ_ERROR_INVALID_PARAM, NPZ_ERROR_NO_REGISTER, NPZ_ERROR_NO_PERIPHERAL);
+    }
 
     if (npz_read_CFGP(psw_lp, &cfgp) != OK)
     {
-        printf("Failed to read CFGP register for peripheral %d\r\n", psw_lp);
-        return false;
+        return set_error(NPZ_ERROR_REGISTER_READ, NPZ_PERIPHERAL_REG(REG_CFGP1, index), index);
     }
 
-    printf("Polling mode: %d\r\n", cfgp.tmod);
+    NPZ_LOG_DEBUG("Peripheral %d triggered, polling mode %d\r\n", index + 1, cfgp.tmod);
 
-    if ((cfgp.tmod == POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD) ||
-        (cfgp.tmod == POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD))
+    if (NPZ_CFG_POLLING_HAS_THRESHOLD(cfgp.tmod))
     {
         if (npz_read_VALP(psw_lp, &valp) != OK)
         {
-            printf("Failed to read VALP register for peripheral %d\r\n", psw_lp);
-            return false;
+            return set_error(NPZ_ERROR_REGISTER_READ, (uint8_t)(REG_VALP1_L + index * 2), index);
         }
 
-        if (npz_read_ADDRP(psw_lp, &addrp) != OK)
-        {
-            printf("Failed to read ADDRP register for peripheral %d\r\n", psw_lp);
-            return false;
-        }
+        // VALP holds the value in the same layout for I2C and SPI peripherals
+        *peripheral_value = npz_device_decode_value(m_modp[index], valp.valp_l, valp.valp_h);
 
-        if (addrp.spi_en == 0) // I2C communication protocol
-        {
-            *peripheral_value = (valp.valp_h << 8) | valp.valp_l;
+        NPZ_LOG_TRACE("Peripheral %d value 0x%02X 0x%02X\r\n", index + 1, valp.valp_h, valp.valp_l);
+    }
 
-            printf("Reading value from I2C Peripheral %d is 0x%02X 0x%02X\r\n", psw_lp,
-                valp.valp_h, valp.valp_l);
-        }
-        else // SPI communication protocol
-        {
-            *peripheral_value = (valp.valp_h << 8) | valp.valp_l;
+    return true;
+}
+
+bool npz_device_prepare_sleep(uint32_t timeout)
+{
+    uint32_t start = npz_hal_get_ms();
+    uint32_t elapsed;
+    bool drained = true;
 
-            printf("Reading value from SPI Peripheral %d is 0x%02X 0x%02X\r\n", psw_lp,
-                valp.valp_h, valp.valp_l);
+    for (uint8_t bus = 0; bus < NPZ_HAL_BUS_COUNT; bus++)
+    {
+        elapsed = npz_hal_get_ms() - start;
+
+        if (npz_hal_is_busy(bus) && (elapsed >= timeout || npz_hal_wait(bus, timeout - elapsed) != OK))
+        {
+            drained = false;
         }
     }
 
-    return true;
+    elapsed = npz_hal_get_ms() - start;
+
+    if (elapsed >= timeout || !npz_hal_flush(timeout - elapsed))
+    {
+        drained = false;
+    }
+
+    return drained;
 }
 
 /**
  * @brief Put npz Device in Sleep mode.
  */
-void npz_device_go_to_sleep(void)
+bool npz_device_go_to_sleep(void)
 {
-    printf("Enter sleep mode and disable I2C bus\r\n");
+    // Logged ahead of the drain, which sends it out with the rest of the output
+    NPZ_LOG_INFO("Enter sleep mode and disable I2C bus\r\n");
+
+    // Sleep anyway after the timeout, output that cannot leave must not keep the host awake
+    npz_device_prepare_sleep(NPZ_SLEEP_DRAIN_TIMEOUT_MS);
 
     uint8_t sleep_rst_value = 0xFF;
     if (npz_write_SLEEP_RST(sleep_rst_value) != OK)
     {
-        printf("Failed to write to SLEEP_RST register\r\n");
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_SLEEP_RST, NPZ_ERROR_NO_PERIPHERAL);
     }
+
+    return true;
 }
 
 /**
  * @brief Reset npz Device by software.
  */
-void npz_device_soft_reset(void)
+bool npz_device_soft_reset(void)
 {
-    printf("Software reset\r\n");
+    NPZ_LOG_INFO("Software reset\r\n");
 
     uint8_t sleep_rst_value = 0xA5;
     if (npz_write_SLEEP_RST(sleep_rst_value) != OK)
     {
-        printf("Failed to write to SLEEP_RST register\r\n");
+        return set_error(NPZ_ERROR_REGISTER_WRITE, REG_SLEEP_RST, NPZ_ERROR_NO_PERIPHERAL);
     }
+
+    return true;
 }
 
 /**
  * @brief Setup npz device configuration.
  */
-void npz_device_configure(npz_device_config_s * device_config)
+npz_status_e npz_device_configure(const npz_device_config_s * device_config)
 {
-    // Ensure the device_config not NULL
-    if (device_config == NULL)
-    {
-        printf("Invalid device configuration pointer\r\n");
-        return;
-    }
+    m_last_error.cause = NPZ_ERROR_NONE;
+    m_last_error.reg = NPZ_ERROR_NO_REGISTER;
+    m_last_error.peripheral = NPZ_ERROR_NO_PERIPHERAL;
 
-    // Configure global settings
-    if (!configure_global_settings(device_config))
+    // Ensure the device_config and both ADC channel configurations are not NULL
+    if (device_config == NULL || device_config->adc_channels[0] == NULL ||
+        device_config->adc_channels[1] == NULL)
     {
-        printf("Failed to configure global settings\r\n");
-        return;
+        set_error(NPZ_ERROR_NULL_CONFIG, NPZ_ERROR_NO_REGISTER, NPZ_ERROR_NO_PERIPHERAL);
+        return INVALID_PARAM;
     }
 
-    // Validate peripherals
-    if (validate_peripherals(device_config))
+    // Init sequences are written from the start of SRAM on every configuration
+    m_sram_count = 0;
+
+    if (!configure_global_settings(device_config) || !validate_peripherals(device_config) ||
+        !configure_peripherals(device_config))
     {
-        // Configure peripherals
-        if (!configure_peripherals(device_config))
-        {
-            printf("Failed to configure peripherals\r\n");
-            return;
-        }
+        return (m_last_error.cause == NPZ_ERROR_REGISTER_WRITE) ? ERR : INVALID_PARAM;
     }
 
     if (device_config->adc_channels[0]->wakeup_enable == 1)
     {
         if (!configure_internal_adc(device_config))
         {
-            printf("Failed to configure internal ADC\r\n");
-            return;
+            return (m_last_error.cause == NPZ_ERROR_REGISTER_WRITE) ? ERR : INVALID_PARAM;
         }
     }
 
@@ -1160,8 +1166,9 @@ void npz_device_configure(npz_device_config_s * device_config)
     {
         if (!configure_external_adc(device_config))
         {
-            printf("Failed to configure external ADC\r\n");
-            return;
+            return (m_last_error.cause == NPZ_ERROR_REGISTER_WRITE) ? ERR : INVALID_PARAM;
         }
     }
+
+    return OK;
 }
@@ -0,0 +1,147 @@
+/**
+ * @file npz_event.c
+ * @brief Implementation of the npz wake source dispatcher.
+ *
+ * The status registers are decoded into a bitmask of npz_event_e and only the handlers of the set bits are called.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+/** Number of registers from VALP1_L up to and including ADC_EXT. */
+#define VALUE_BURST_SIZE (REG_ADC_EXT - REG_VALP1_L + 1)
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+static npz_event_handler_t m_handlers[NPZ_EVENT_COUNT] = {0}; /**< Handler per event bit. */
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Builds the event bitmask from the two status registers.
+ */
+static uint16_t decode_events(uint8_t sta1, uint8_t sta2)
+{
+    uint16_t events = 0;
+
+    // STA2 interleaves the trigger and timeout flag of each peripheral
+    for (int i = 0; i < 4; i++)
+    {
+        if (sta2 & (0x01 << (2 * i)))
+        {
+            events |= NPZ_EVENT_PER1_TRIGGER << i;
+        }
+
+        if (sta2 & (0x02 << (2 * i)))
+        {
+            events |= NPZ_EVENT_PER1_TIMEOUT << i;
+        }
+    }
+
+    if (sta1 & 0x20)
+    {
+        events |= NPZ_EVENT_ADC_EXTERNAL;
+    }
+
+    if (sta1 & 0x40)
+    {
+        events |= NPZ_EVENT_ADC_INTERNAL;
+    }
+
+    if (sta1 & 0x80)
+    {
+        events |= NPZ_EVENT_GLOBAL_TIMEOUT;
+    }
+
+    if ((sta1 & 0x07) != RESETSOURCE_NONE)
+    {
+        events |= NPZ_EVENT_RESET;
+    }
+
+    return events;
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_event_register(uint16_t events, npz_event_handler_t handler)
+{
+    for (int bit = 0; bit < NPZ_EVENT_COUNT; bit++)
+    {
+        if (events & (1U << bit))
+        {
+            m_handlers[bit] = handler;
+        }
+    }
+}
+
+npz_status_e npz_process_wake(npz_wake_s *wake)
+{
+    npz_wake_s local_wake;
+    uint8_t status[2] = {0};
+    uint8_t values[VALUE_BURST_SIZE] = {0};
+
+    if (wake == NULL)
+    {
+        wake = &local_wake;
+    }
+
+    memset(wake, 0, sizeof(*wake));
+
+    // STA1 and STA2 are adjacent, so one transfer fetches both
+    if (npz_read_register(REG_STA1, status, sizeof(status)) != OK)
+    {
+        return ERR;
+    }
+
+    memcpy(&wake->sta1, &status[0], 1);
+    memcpy(&wake->sta2, &status[1], 1);
+    wake->events = decode_events(status[0], status[1]);
+
+    if (wake->events & (NPZ_EVENT_PER_TRIGGER_ALL | NPZ_EVENT_ADC_INTERNAL | NPZ_EVENT_ADC_EXTERNAL))
+    {
+        if (npz_read_register(REG_VALP1_L, values, sizeof(values)) != OK)
+        {
+            return ERR;
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            wake->valp[i] = (uint16_t)((values[2 * i + 1] << 8) | values[2 * i]);
+        }
+
+        npz_device_decode_values(values, wake->value);
+
+        wake->adc_core = values[REG_ADC_CORE - REG_VALP1_L];
+        wake->adc_ext = values[REG_ADC_EXT - REG_VALP1_L];
+    }
+
+    // Walk the set bits only, lowest first
+    uint16_t pending = wake->events;
+    while (pending != 0)
+    {
+        int bit = __builtin_ctz(pending);
+        pending &= pending - 1;
+
+        if (m_handlers[bit] != NULL)
+        {
+            // Bits 0-3 are the triggers and 4-7 the timeouts of peripherals 1-4
+            int index = (bit < 8) ? (bit & 0x03) : -1;
+            m_handlers[bit]((npz_event_e)(1U << bit), index, wake);
+        }
+    }
+
+    return OK;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file npz_fleet.c
+ * @brief Implementation of the npz fleet manager.
+ *
+ * Register images are captured once per distinct configuration. Writes are replayed one register at a time, with
+ * one transfer in flight per bus.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define NO_DEVICE 0xFF
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+/** Sleep command sent by npz_fleet_sleep(), see npz_device_go_to_sleep(). */
+static const uint8_t m_sleep_reg = REG_SLEEP_RST;
+static const uint8_t m_sleep_value = 0xFF;
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+static bool images_equal(const npz_image_s *a, const npz_image_s *b)
+{
+    return (a->count == b->count) && (memcmp(a->reg, b->reg, a->count) == 0) &&
+        (memcmp(a->value, b->value, a->count) == 0);
+}
+
+/**
+ * @brief Replays register writes to all devices, keeping one transfer in flight on every bus.
+ *
+ * With use_images false, each device gets the sleep command only.
+ */
+static npz_status_e replay(npz_fleet_s *fleet, bool use_images)
+{
+    uint16_t cursor[NPZ_FLEET_MAX_DEVICES] = {0};
+    uint8_t in_flight[NPZ_HAL_BUS_COUNT];
+    uint8_t next[NPZ_HAL_BUS_COUNT] = {0};
+    uint8_t transmitData[NPZ_HAL_BUS_COUNT][2];
+    bool active = true;
+
+    memset(in_flight, NO_DEVICE, sizeof(in_flight));
+
+    for (uint8_t d = 0; d < fleet->count; d++)
+    {
+        fleet->status[d] = OK;
+    }
+
+    while (active)
+    {
+        active = false;
+
+        // Start the next write of one device on every bus
+        for (uint8_t bus = 0; bus < NPZ_HAL_BUS_COUNT; bus++)
+        {
+            for (uint8_t n = 0; n < fleet->count; n++)
+            {
+                uint8_t d = (uint8_t)((next[bus] + n) % fleet->count);
+                const npz_image_s *image = &fleet->images[fleet->image_of[d]];
+                uint16_t length = use_images ? image->count : 1;
+
+                if (fleet->devices[d].bus != bus || fleet->status[d] != OK || cursor[d] >= length)
+                {
+                    continue;
+                }
+
+                transmitData[bus][0] = use_images ? image->reg[cursor[d]] : m_sleep_reg;
+                transmitData[bus][1] = use_images ? image->value[cursor[d]] : m_sleep_value;
+
+                if (npz_hal_write_start(bus, fleet->devices[d].address, transmitData[bus], 2) == OK)
+                {
+                    in_flight[bus] = d;
+                }
+                else
+                {
+                    fleet->status[d] = ERR;
+                }
+
+                // Rotate so devices sharing a bus take turns
+                next[bus] = (uint8_t)((d + 1) % fleet->count);
+                active = true;
+                break;
+            }
+        }
+
+        // The transfers run in parallel, so waiting on them in turn costs the longest one only
+        for (uint8_t bus = 0; bus < NPZ_HAL_BUS_COUNT; bus++)
+        {
+            uint8_t d = in_flight[bus];
+
+            if (d == NO_DEVICE)
+            {
+                continue;
+            }
+
+            if (npz_hal_wait(bus, I2C_TRANSMISSION_TIMEOUT_MS) != OK)
+            {
+                fleet->status[d] = ERR;
+            }
+
+            cursor[d]++;
+            in_flight[bus] = NO_DEVICE;
+        }
+    }
+
+    for (uint8_t d = 0; d < fleet->count; d++)
+    {
+        if (fleet->status[d] != OK)
+        {
+            return ERR;
+        }
+    }
+
+    return OK;
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_status_e npz_fleet_init(npz_fleet_s *fleet, const npz_fleet_device_s *devices, uint8_t count)
+{
+    if (fleet == NULL || devices == NULL || count == 0 || count > NPZ_FLEET_MAX_DEVICES)
+    {
+        return INVALID_PARAM;
+    }
+
+    fleet->devices = devices;
+    fleet->count = count;
+    fleet->image_count = 0;
+
+    for (uint8_t d = 0; d < count; d++)
+    {
+        uint8_t shared = NO_DEVICE;
+
+        fleet->status[d] = OK;
+
+        if (devices[d].bus >= NPZ_HAL_BUS_COUNT)
+        {
+            fleet->status[d] = INVALID_PARAM;
+            return INVALID_PARAM;
+        }
+
+        // Same configuration object as an earlier device, no need to run it again
+        for (uint8_t e = 0; e < d; e++)
+        {
+            if (devices[e].config == devices[d].config)
+            {
+                shared = fleet->image_of[e];
+                break;
+            }
+        }
+
+        if (shared == NO_DEVICE)
+        {
+            npz_image_s *image;
+            npz_status_e status;
+
+            if (fleet->image_count >= NPZ_FLEET_MAX_IMAGES)
+            {
+                fleet->status[d] = INVALID_PARAM;
+                return INVALID_PARAM;
+            }
+
+            image = &fleet->images[fleet->image_count];
+
+            npz_capture_begin(image);
+            status = npz_device_configure(devices[d].config);
+            if (npz_capture_end() != OK)
+            {
+                status = ERR;
+            }
+
+            if (status != OK)
+            {
+                fleet->status[d] = status;
+                return status;
+            }
+
+            // Separate configuration objects can still produce the same registers
+            for (uint8_t i = 0; i < fleet->image_count; i++)
+            {
+                if (images_equal(&fleet->images[i], image))
+                {
+                    shared = i;
+                    break;
+                }
+            }
+
+            if (shared == NO_DEVICE)
+            {
+                shared = fleet->image_count++;
+            }
+        }
+
+        fleet->image_of[d] = shared;
+    }
+
+    return OK;
+}
+
+npz_status_e npz_fleet_configure(npz_fleet_s *fleet)
+{
+    if (fleet == NULL || fleet->count == 0)
+    {
+        return INVALID_PARAM;
+    }
+
+    return replay(fleet, true);
+}
+
+npz_status_e npz_fleet_read_status(npz_fleet_s *fleet, npz_status_s *status)
+{
+    npz_status_e result = OK;
+
+    if (fleet == NULL || status == NULL)
+    {
+        return INVALID_PARAM;
+    }
+
+    for (uint8_t d = 0; d < fleet->count; d++)
+    {
+        uint8_t data[2] = {0};
+
+        memset(&status[d], 0, sizeof(status[d]));
+
+        // STA1 and STA2 are adjacent, read both in one transfer
+        npz_set_device(fleet->devices[d].bus, fleet->devices[d].address);
+        fleet->status[d] = npz_read_register(REG_STA1, data, sizeof(data));
+
+        if (fleet->status[d] == OK)
+        {
+            memcpy(&status[d].status1, &data[0], 1);
+            memcpy(&status[d].status2, &data[1], 1);
+        }
+        else
+        {
+            result = ERR;
+        }
+    }
+
+    npz_set_device(0, NPZ_I2C_ADDRESS);
+
+    return result;
+}
+
+npz_status_e npz_fleet_sleep(npz_fleet_s *fleet)
+{
+    if (fleet == NULL || fleet->count == 0)
+    {
+        return INVALID_PARAM;
+    }
+
+    // The device that powers the host may be on the list, nothing may be left to send once it sleeps
+    npz_device_prepare_sleep(NPZ_SLEEP_DRAIN_TIMEOUT_MS);
+
+    return replay(fleet, false);
+}
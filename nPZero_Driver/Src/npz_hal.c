@@ -32,14 +32,125 @@
 
 #define I2C_DELAY_MS 1
 
+#define NVMOP_WORD_PROGRAM 0x1
+#define NVMOP_PAGE_ERASE   0x4
+
+/** Core timer ticks of the 10 us allowed for the low-voltage detect start-up, at least 6 us by the datasheet. */
+#define NVM_LVD_WAIT_TICKS (TICK_PER_MS / 100)
+
 /*****************************************************************************
  * Data
  *****************************************************************************/
 
+/** Harmony I2C plib entry points of one bus. */
+typedef struct
+{
+    bool (*write)(uint16_t address, uint8_t *wdata, size_t wlength);
+    bool (*write_read)(uint16_t address, uint8_t *wdata, size_t wlength, uint8_t *rdata, size_t rlength);
+    bool (*is_busy)(void);
+    I2C_ERROR (*error_get)(void);
+} hal_bus_s;
+
+/** Buses available to the driver, indexed by bus number. Add I2C2 here when it is enabled in Harmony. */
+static const hal_bus_s m_buses[NPZ_HAL_BUS_COUNT] = {
+    {I2C1_Write, I2C1_WriteRead, I2C1_IsBusy, I2C1_ErrorGet},
+};
+
+static uint8_t m_bus = 0; /**< Bus used by npz_hal_read() and npz_hal_write(). */
+
+static uint32_t m_ms;       /**< Milliseconds since power-up at m_ms_ticks. */
+static uint32_t m_ms_ticks; /**< Core timer count m_ms was last advanced to, 0 at power-up. */
+
+static npz_hal_flush_f m_flush; /**< Hook of npz_hal_flush(), NULL if none. */
+
+static npz_hal_uart_done_f m_uart_done;     /**< Callback of the npz_hal_uart_write() in progress. */
+static npz_hal_uart_done_f m_uart_dma_done; /**< Callback of the npz_hal_uart_dma_write() in progress. */
+static bool m_uart_locked;                  /**< Between npz_hal_uart_lock() and npz_hal_uart_unlock(). */
+static uint32_t m_uart_armed;               /**< Interrupts enabled by writes started while locked. */
+static npz_hal_uart_receive_f m_uart_receive; /**< Callback of npz_hal_uart_receive_start(). */
+static uint8_t m_uart_rx_byte;                /**< Byte being received by the plib. */
+
 /*****************************************************************************
  * Private Methods
  *****************************************************************************/
 
+/**
+ * @brief Converts the left-shifted address used by the driver to the 7-bit address expected by the plib.
+ */
+static uint16_t plib_address(uint8_t slave_address)
+{
+    return (uint16_t)(slave_address >> 1);
+}
+
+/**
+ * @brief Runs one operation of the flash controller, following the unlock sequence of the NVM section of the
+ * reference manual.
+ */
+static npz_status_e flash_operation(const void *address, uint32_t operation)
+{
+    uint32_t start;
+    bool interrupts;
+
+    NVMADDR = KVA_TO_PA((uintptr_t) address);
+    NVMCON = _NVMCON_WREN_MASK | operation;
+
+    // The low-voltage detect circuit needs 6 us to start once WREN is set
+    start = _CP0_GET_COUNT();
+    while ((_CP0_GET_COUNT() - start) < NVM_LVD_WAIT_TICKS)
+    {
+    }
+
+    // Nothing may come between the two keys and WR
+    interrupts = EVIC_INT_Disable();
+    NVMKEY = 0xAA996655U;
+    NVMKEY = 0x556699AAU;
+    NVMCONSET = _NVMCON_WR_MASK;
+    EVIC_INT_Restore(interrupts);
+
+    while (NVMCON & _NVMCON_WR_MASK)
+    {
+    }
+
+    NVMCONCLR = _NVMCON_WREN_MASK;
+
+    return (NVMCON & (_NVMCON_WRERR_MASK | _NVMCON_LVDERR_MASK)) ? ERR : OK;
+}
+
+/**
+ * @brief Write callback of the UART1 plib, called from the transmit interrupt.
+ */
+static void uart_write_done(uintptr_t context)
+{
+    if (m_uart_done != NULL)
+    {
+        m_uart_done(true);
+    }
+}
+
+/**
+ * @brief Read callback of the UART1 plib, called from the receive and error interrupts.
+ */
+static void uart_read_done(uintptr_t context)
+{
+    if (m_uart_receive != NULL)
+    {
+        m_uart_receive(m_uart_rx_byte, UART1_ErrorGet() == UART_ERROR_NONE);
+    }
+
+    UART1_Read(&m_uart_rx_byte, 1);
+}
+
+/**
+ * @brief DMA write callback of the UART1 plib, called from the transmit interrupt.
+ */
+static void uart_dma_done(uintptr_t context)
+{
+    if (m_uart_dma_done != NULL)
+    {
+        m_uart_dma_done(!UART1_DMAWriteErrorGet());
+    }
+}
+
 /*****************************************************************************
  * Public Methods
  *****************************************************************************/
@@ -49,9 +160,13 @@
  */
 npz_status_e npz_hal_read(uint8_t slave_address, uint8_t slave_register, uint8_t *pData, uint16_t size, uint32_t timeout)
 {
-    I2C1_WriteRead(slave_address, slave_register, pData, size);
-    
-	return OK;
+    if (!m_buses[m_bus].write_read(plib_address(slave_address), &slave_register, 1, pData, size))
+    {
+        return ERR;
+    }
+
+    // The plib is interrupt driven, slave_register and pData must stay valid until the transfer is done
+    return npz_hal_wait(m_bus, timeout);
 }
 
 /**
@@ -59,9 +174,253 @@ npz_status_e npz_hal_read(uint8_t slave_address, uint8_t slave_register, uint8_t
  */
 npz_status_e npz_hal_write(uint8_t slave_address, uint8_t *pData, uint16_t size, uint32_t timeout)
 {
-    I2C1_Write(slave_address, pData, size);
-    
-	return OK;
+    if (npz_hal_write_start(m_bus, slave_address, pData, size) != OK)
+    {
+        return ERR;
+    }
+
+    return npz_hal_wait(m_bus, timeout);
+}
+
+/**
+ * @brief Function to select the bus used by npz_hal_read() and npz_hal_write().
+ */
+npz_status_e npz_hal_select_bus(uint8_t bus)
+{
+    if (bus >= NPZ_HAL_BUS_COUNT)
+    {
+        return INVALID_PARAM;
+    }
+
+    m_bus = bus;
+
+    return OK;
+}
+
+/**
+ * @brief Function to start a write without waiting for it to complete.
+ */
+npz_status_e npz_hal_write_start(uint8_t bus, uint8_t slave_address, uint8_t *pData, uint16_t size)
+{
+    if (bus >= NPZ_HAL_BUS_COUNT)
+    {
+        return INVALID_PARAM;
+    }
+
+    return m_buses[bus].write(plib_address(slave_address), pData, size) ? OK : ERR;
+}
+
+/**
+ * @brief Function to check if a bus has a transfer in progress.
+ */
+bool npz_hal_is_busy(uint8_t bus)
+{
+    return (bus < NPZ_HAL_BUS_COUNT) && m_buses[bus].is_busy();
+}
+
+/**
+ * @brief Function to wait for the transfer on a bus to complete.
+ */
+npz_status_e npz_hal_wait(uint8_t bus, uint32_t timeout)
+{
+    uint32_t start = npz_hal_get_ms();
+
+    if (bus >= NPZ_HAL_BUS_COUNT)
+    {
+        return INVALID_PARAM;
+    }
+
+    while (m_buses[bus].is_busy())
+    {
+        if ((npz_hal_get_ms() - start) > timeout)
+        {
+            return ERR;
+        }
+    }
+
+    return (m_buses[bus].error_get() == I2C_ERROR_NONE) ? OK : ERR;
+}
+
+/**
+ * @brief Function to erase one page of program flash.
+ */
+npz_status_e npz_hal_flash_erase(const void *page)
+{
+    if (((uintptr_t) page % NPZ_HAL_FLASH_PAGE_SIZE) != 0)
+    {
+        return INVALID_PARAM;
+    }
+
+    return flash_operation(page, NVMOP_PAGE_ERASE);
+}
+
+/**
+ * @brief Function to program one word of program flash.
+ */
+npz_status_e npz_hal_flash_write_word(const void *address, uint32_t word)
+{
+    if (((uintptr_t) address % 4) != 0)
+    {
+        return INVALID_PARAM;
+    }
+
+    NVMDATA = word;
+
+    return flash_operation(address, NVMOP_WORD_PROGRAM);
+}
+
+/**
+ * @brief Function to check if the console UART is powered.
+ */
+bool npz_hal_uart_is_on(void)
+{
+    return (U1MODE & _U1MODE_ON_MASK) != 0;
+}
+
+/**
+ * @brief Function to keep the UART transmit and DMA interrupts from running.
+ */
+uint32_t npz_hal_uart_lock(void)
+{
+    uint32_t state = IEC1 & (_IEC1_U1TXIE_MASK | _IEC1_DMA0IE_MASK);
+
+    // The DMA interrupt enables the transmit interrupt once its block is out, so both are held
+    IEC1CLR = _IEC1_U1TXIE_MASK | _IEC1_DMA0IE_MASK;
+    m_uart_locked = true;
+
+    return state;
+}
+
+/**
+ * @brief Function to let the UART transmit and DMA interrupts run again.
+ */
+void npz_hal_uart_unlock(uint32_t state)
+{
+    uint32_t armed = m_uart_armed;
+
+    m_uart_armed = 0;
+    m_uart_locked = false;
+    IEC1SET = state | armed;
+}
+
+/**
+ * @brief Function to start sending bytes over the UART from its transmit interrupt.
+ */
+bool npz_hal_uart_write(const uint8_t *data, uint16_t size, npz_hal_uart_done_f done)
+{
+    if (!npz_hal_uart_is_on() || UART1_WriteIsBusy())
+    {
+        return false;
+    }
+
+    // UART1_Initialize() forgets the callback, register it with every write
+    m_uart_done = done;
+    UART1_WriteCallbackRegister(uart_write_done, 0);
+
+    if (!UART1_Write((void *) data, size))
+    {
+        return false;
+    }
+
+    // The plib enables the transmit interrupt right away, inside a lock that is left to npz_hal_uart_unlock()
+    if (m_uart_locked)
+    {
+        IEC1CLR = _IEC1_U1TXIE_MASK;
+        m_uart_armed |= _IEC1_U1TXIE_MASK;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Function to start sending bytes over the UART by DMA.
+ */
+bool npz_hal_uart_dma_write(const void *data, uint16_t size, npz_hal_uart_done_f done)
+{
+    if (!npz_hal_uart_is_on() || UART1_WriteIsBusy())
+    {
+        return false;
+    }
+
+    m_uart_dma_done = done;
+    UART1_DMAWriteCallbackRegister(uart_dma_done, 0);
+
+    return UART1_DMAWrite((void *) data, size);
+}
+
+/**
+ * @brief Function to check if the UART has a write in progress.
+ */
+bool npz_hal_uart_is_busy(void)
+{
+    return UART1_WriteIsBusy();
+}
+
+/**
+ * @brief Function to check if the last stop bit has left the UART.
+ */
+bool npz_hal_uart_is_sent(void)
+{
+    return !UART1_WriteIsBusy() && UART1_TransmitComplete();
+}
+
+/**
+ * @brief Function to start handing received UART bytes to a callback.
+ */
+bool npz_hal_uart_receive_start(npz_hal_uart_receive_f receive)
+{
+    if (receive == NULL || !npz_hal_uart_is_on() || UART1_ReadIsBusy())
+    {
+        return false;
+    }
+
+    // One byte per read, the callback re-arms it
+    m_uart_receive = receive;
+    UART1_ReadCallbackRegister(uart_read_done, 0);
+
+    return UART1_Read(&m_uart_rx_byte, 1);
+}
+
+/**
+ * @brief Function to stop the reception of npz_hal_uart_receive_start().
+ */
+void npz_hal_uart_receive_stop(void)
+{
+    UART1_ReadAbort();
+    m_uart_receive = NULL;
+}
+
+/**
+ * @brief Function to get the time since power-up in milliseconds.
+ */
+uint32_t npz_hal_get_ms(void)
+{
+    bool interrupts = EVIC_INT_Disable();
+    uint32_t elapsed = (_CP0_GET_COUNT() - m_ms_ticks) / TICK_PER_MS;
+
+    // Only whole milliseconds are taken, the remaining ticks count towards the next call
+    m_ms_ticks += elapsed * TICK_PER_MS;
+    m_ms += elapsed;
+
+    EVIC_INT_Restore(interrupts);
+
+    return m_ms;
+}
+
+/**
+ * @brief Function to register the hook that sends pending application output.
+ */
+void npz_hal_set_flush(npz_hal_flush_f flush)
+{
+    m_flush = flush;
+}
+
+/**
+ * @brief Function to send pending application output with the registered hook.
+ */
+bool npz_hal_flush(uint32_t timeout)
+{
+    return (m_flush == NULL) || m_flush(timeout);
 }
 
 /**
@@ -0,0 +1,165 @@
+/**
+ * @file npz_history.c
+ * @brief Implementation of the wake-up sample history.
+ *
+ * Samples are addressed by a free running 32-bit sequence number. The slot of a sample is its sequence number masked
+ * with the ring size, so appending is a store and an increment.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define HISTORY_MASK (NPZ_HISTORY_SIZE - 1)
+
+/** Events that come with a value. */
+#define VALUE_EVENTS (NPZ_EVENT_PER_TRIGGER_ALL | NPZ_EVENT_ADC_INTERNAL | NPZ_EVENT_ADC_EXTERNAL)
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Sequence number of the oldest sample that was neither exported nor overwritten.
+ */
+static uint32_t first_pending(const npz_history_s *history)
+{
+    if (history->head - history->exported > NPZ_HISTORY_SIZE)
+    {
+        return history->head - NPZ_HISTORY_SIZE;
+    }
+
+    return history->exported;
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_history_clear(npz_history_s *history)
+{
+    history->head = 0;
+    history->exported = 0;
+    history->wakes = 0;
+}
+
+void npz_history_append(npz_history_s *history, const npz_history_sample_s *sample)
+{
+    history->samples[history->head & HISTORY_MASK] = *sample;
+    history->head++;
+}
+
+void npz_history_record_wake(npz_history_s *history, const npz_wake_s *wake, uint32_t timestamp)
+{
+    npz_history_sample_s sample;
+    uint16_t pending = wake->events & VALUE_EVENTS;
+
+    sample.timestamp = timestamp;
+
+    while (pending != 0)
+    {
+        int bit = __builtin_ctz(pending);
+        pending &= pending - 1;
+
+        sample.reason = (uint16_t)(1U << bit);
+
+        if (sample.reason == NPZ_EVENT_ADC_INTERNAL)
+        {
+            sample.peripheral = NPZ_HISTORY_NO_PERIPHERAL;
+            sample.raw = wake->adc_core;
+        }
+        else if (sample.reason == NPZ_EVENT_ADC_EXTERNAL)
+        {
+            sample.peripheral = NPZ_HISTORY_NO_PERIPHERAL;
+            sample.raw = wake->adc_ext;
+        }
+        else
+        {
+            sample.peripheral = (uint8_t)bit;
+            sample.raw = wake->valp[bit];
+        }
+
+        npz_history_append(history, &sample);
+    }
+
+    if (history->wakes < UINT16_MAX)
+    {
+        history->wakes++;
+    }
+}
+
+uint16_t npz_history_pending(const npz_history_s *history)
+{
+    return (uint16_t)(history->head - first_pending(history));
+}
+
+uint32_t npz_history_dropped(const npz_history_s *history)
+{
+    return first_pending(history) - history->exported;
+}
+
+void npz_history_iter_begin(const npz_history_s *history, npz_history_iter_s *iter)
+{
+    iter->next = first_pending(history);
+    iter->end = history->head;
+}
+
+const npz_history_sample_s *npz_history_iter_next(const npz_history_s *history, npz_history_iter_s *iter)
+{
+    // Skip what was overwritten since the last call
+    if (history->head - iter->next > NPZ_HISTORY_SIZE)
+    {
+        iter->next = history->head - NPZ_HISTORY_SIZE;
+    }
+
+    if ((int32_t)(iter->end - iter->next) <= 0)
+    {
+        return NULL;
+    }
+
+    return &history->samples[iter->next++ & HISTORY_MASK];
+}
+
+npz_status_e npz_history_export(npz_history_s *history, npz_history_sink_t sink, void *context)
+{
+    uint32_t next;
+
+    if (history == NULL || sink == NULL)
+    {
+        return INVALID_PARAM;
+    }
+
+    next = first_pending(history);
+
+    // At most two runs: up to the end of the storage, then from its start
+    while (next != history->head)
+    {
+        uint16_t slot = (uint16_t)(next & HISTORY_MASK);
+        uint32_t count = history->head - next;
+        uint32_t room = (uint32_t)NPZ_HISTORY_SIZE - slot;
+
+        if (count > room)
+        {
+            count = room;
+        }
+
+        if (!sink(&history->samples[slot], (uint16_t)count, context))
+        {
+            history->exported = next;
+            return ERR;
+        }
+
+        next += count;
+    }
+
+    history->exported = next;
+    history->wakes = 0;
+
+    return OK;
+}
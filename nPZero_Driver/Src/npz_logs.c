@@ -15,13 +15,40 @@
  * Defines
  *****************************************************************************/
 
+/** Record types of the binary format, see npz_logs.h. */
+#define RECORD_TABLE    0x01
+#define RECORD_REGISTER 0x02
+#define RECORD_END      0x03
+
+#define RECORD_SIZE 5
+
+/** Tables, the address field of a RECORD_TABLE. Peripherals 1 to 4 are TABLE_PERIPHERAL_1 to 5. */
+#define TABLE_GLOBAL       0
+#define TABLE_STATUS       1
+#define TABLE_PERIPHERAL_1 2
+#define TABLE_ADC_INTERNAL 6
+#define TABLE_ADC_EXTERNAL 7
+
+/** Rows of peripheral_registers that depend on the polling mode. */
+#define PERIPHERAL_ROW_ADDRP    5
+#define PERIPHERAL_ROW_RREGP    6
+#define PERIPHERAL_ROW_THROVP_H 10
+
 /*****************************************************************************
  * Data
  *****************************************************************************/
 
-// Array to hold indices of configured peripherals
-static int m_configured_indices[4] = {-1, -1, -1, -1}; /**< Initialize with invalid indices. */
-static int m_configured_count = 0;
+/** Title line of each table of the text format, indexed by table. */
+static const char *const m_table_titles[] = {
+    "          Read global registers               ",
+    "          Read status registers               ",
+    "         Read peripheral 1 registers       ",
+    "         Read peripheral 2 registers       ",
+    "         Read peripheral 3 registers       ",
+    "         Read peripheral 4 registers       ",
+    "          Read internal adc registers         ",
+    "          Read external adc registers          ",
+};
 
 // Define a struct to hold register address and description
 typedef struct
@@ -85,409 +112,261 @@ static char *char_to_binary_string(uint8_t byte, char *buffer)
     return buffer;
 }
 
+/**
+ * @brief Sends one record of the binary format as a COBS frame.
+ */
+static void write_record(uint8_t type, uint8_t address, uint8_t value)
+{
+    // Milliseconds since power-up, modulo 2^16
+    uint16_t timestamp = (uint16_t)npz_hal_get_ms();
+    uint8_t record[RECORD_SIZE] = {type, address, value, (uint8_t)timestamp, (uint8_t)(timestamp >> 8)};
+    uint8_t frame[NPZ_COBS_MAX_ENCODED(RECORD_SIZE) + 1];
+    size_t length = npz_cobs_encode(record, sizeof(record), frame);
+
+    frame[length++] = NPZ_COBS_DELIMITER;
+    fwrite(frame, 1, length, stdout);
+}
 
-static void log_register_data(const char *register_name, uint8_t register_address, uint8_t *values, int count)
+static void log_table_begin(uint8_t table)
 {
-    char binary_str[9];         // Buffer to hold binary strings for each register value
-    char combined_bin[17] = ""; // Buffer to hold combined binary strings for display, limited to 16 bits
-    char combined_hex[7] = "";  // Buffer to hold 4-character hex strings for display with "0x" prefix
-
-    // Combine binary values in little-endian order (LSB first) and hex representation
-    for (int i = 0; i < count && i < 2; i++)
-    { // Limit to 2 bytes for 16-bit display
-        char_to_binary_string(values[i], binary_str);
-        strcat(combined_bin, binary_str);
+    if (NPZ_LOG_FORMAT == NPZ_LOG_FORMAT_BINARY)
+    {
+        // A delimiter first, so text written before is not taken as part of the frame
+        putchar(NPZ_COBS_DELIMITER);
+        write_record(RECORD_TABLE, table, 0);
+        return;
     }
 
-    // Format HEX output as 4 characters long with "0x" prefix, showing LSB first
+    printf("----------------------------------------------\r\n");
+    printf("%s\r\n", m_table_titles[table]);
+    printf("----------------------------------------------\r\n");
+    printf("[  ADDR |    REGISTER    |     BIN    | HEX  ]\r\n");
+    printf("----------------------------------------------\r\n");
+}
 
-    if (count == 1)
-    {
-        sprintf(combined_hex, "0x%02X ", values[0]); // Pad with 00 if only one byte
-    }
-    else
+static void log_table_end(void)
+{
+    if (NPZ_LOG_FORMAT == NPZ_LOG_FORMAT_BINARY)
     {
-        sprintf(combined_hex, "0x00 "); // Pad with 0000 if no bytes
+        write_record(RECORD_END, 0, 0);
+        return;
     }
 
-    combined_bin[16] = '\0'; // Ensure the binary string is exactly 16 bits
-
-    // Print the register data in the specified format with proper alignment
-    printf("[  %02X   | %-14s | %-10s | %-4s ] \r\n", register_address, register_name, combined_bin, combined_hex);
+    printf("----------------------------------------------\r\n");
 }
 
-static bool read_peripherals(npz_device_config_s *device_config)
+static void log_register(const char *register_name, uint8_t register_address, uint8_t value)
 {
-    npz_psw_e switches[4] = {PSW_LP1, PSW_LP2, PSW_LP3, PSW_LP4}; // Corresponding switches
+    char binary_str[9];
 
-    // Iterate through the peripherals
-    for (int j = 0; j < m_configured_count; j++)
+    if (NPZ_LOG_FORMAT == NPZ_LOG_FORMAT_BINARY)
     {
-        npz_register_cfgp_s cfgp = {0};
-        npz_register_modp_s modp = {0};
-        npz_register_perp_s perp = {0};
-        npz_register_ncmdp_s ncmdp = {0};
-        npz_register_twtp_s twtp = {0};
-        npz_register_tcfgp_s tcfgp = {0};
-
-        int i = m_configured_indices[j]; // Get the index of the configured peripheral
-
-        // Log the header for the table
-        printf("----------------------------------------------\r\n");
-        printf("         Read peripheral %d registers       \r\n", i + 1);
-        printf("----------------------------------------------\r\n");
-        printf("[  ADDR |    REGISTER    |     BIN    | HEX  ]\r\n");
-        printf("----------------------------------------------\r\n");
-
-        // Read and log CFGP register
-        if (npz_read_CFGP(switches[i], &cfgp) == OK)
-        {
-            log_register_data(peripheral_registers[i][0].reg_name, peripheral_registers[i][0].reg_address,
-                              (uint8_t *) &cfgp, sizeof(cfgp));
-        }
-        else
-        {
-            printf("Failed to read CFGP register for peripheral %d \r\n", i + 1);
-            return false;
-        }
+        write_record(RECORD_REGISTER, register_address, value);
+        return;
+    }
 
-        // Read and log MODP register
-        if (npz_read_MODP(switches[i], &modp) == OK)
-        {
-            log_register_data(peripheral_registers[i][1].reg_name, peripheral_registers[i][1].reg_address,
-                              (uint8_t *) &modp, sizeof(modp));
-        }
-        else
-        {
-            printf("Failed to read MODP register for peripheral %d \r\n", i + 1);
-            return false;
-        }
+    // Print the register data in the specified format with proper alignment
+    printf("[  %02X   | %-14s | %-10s | 0x%02X ] \r\n", register_address, register_name,
+           char_to_binary_string(value, binary_str), value);
+}
 
-        // Read and log PERP register (split into low and high bytes)
-        if (npz_read_PERP(switches[i], &perp) == OK)
-        {
-            log_register_data(peripheral_registers[i][2].reg_name, peripheral_registers[i][2].reg_address,
-                              (uint8_t *) &perp.perp_l, 1);
-            log_register_data(peripheral_registers[i][3].reg_name, peripheral_registers[i][3].reg_address,
-                              (uint8_t *) &perp.perp_h, 1);
-        }
-        else
-        {
-            printf("Failed to read PERP register for peripheral %d \r\n", i + 1);
-            return false;
-        }
+/**
+ * @brief Logs the registers of every configured peripheral.
+ *
+ * ADDRP is only listed for polling modes that address a peripheral register, RREGP and the thresholds only for
+ * modes that compare the value, as the other modes leave them unused.
+ */
+static void log_peripherals(const npz_device_config_s *device_config, const npz_register_dump_s *dump)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        const npz_peripheral_config_s *peripheral = device_config->peripherals[i];
 
-        // Read and log NCMDP register
-        if (npz_read_NCMDP(switches[i], &ncmdp) == OK)
+        if (!NPZ_CFG_PERIPHERAL_ENABLED(i) || peripheral == NULL)
         {
-            log_register_data(peripheral_registers[i][4].reg_name, peripheral_registers[i][4].reg_address,
-                              (uint8_t *) &ncmdp, sizeof(ncmdp));
-        }
-        else
-        {
-            printf("Failed to read NCMDP register for peripheral %d \r\n", i + 1);
-            return false;
+            continue;
         }
 
-        if ((device_config->peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD) ||
-            (device_config->peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD) ||
-            (device_config->peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_WAIT_INTERRUPT))
-        {
-            npz_register_addrp_s addrp = {0};
+        log_table_begin((uint8_t)(TABLE_PERIPHERAL_1 + i));
 
-            // Read and log ADDRP register
-            if (npz_read_ADDRP(switches[i], &addrp) == OK)
-            {
-                log_register_data(peripheral_registers[i][5].reg_name, peripheral_registers[i][5].reg_address,
-                                  (uint8_t *) &addrp, sizeof(addrp));
-            }
-            else
-            {
-                printf("Failed to read ADDRP register for peripheral %d \r\n", i + 1);
-                return false;
-            }
-        }
-
-        if ((device_config->peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD) ||
-            (device_config->peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD))
+        for (int r = 0; r < 13; r++)
         {
-            npz_register_rregp_s rregp = {0};
-            npz_register_thrunp_s thrunp = {0};
-            npz_register_throvp_s throvp = {0};
-
-            // Read and log RREGP register
-            if (npz_read_RREGP(switches[i], &rregp) == OK)
-            {
-                log_register_data(peripheral_registers[i][6].reg_name, peripheral_registers[i][6].reg_address,
-                                  (uint8_t *) &rregp, sizeof(rregp));
-            }
-            else
-            {
-                printf("Failed to read RREGP register for peripheral %d \r\n", i + 1);
-                return false;
-            }
-
-            // Read and log THRUNP register (split into low and high bytes)
-            if (npz_read_THRUNP(switches[i], &thrunp) == OK)
-            {
-                log_register_data(peripheral_registers[i][7].reg_name, peripheral_registers[i][7].reg_address,
-                                  (uint8_t *) &thrunp.thrunp_l, 1);
-                log_register_data(peripheral_registers[i][8].reg_name, peripheral_registers[i][8].reg_address,
-                                  (uint8_t *) &thrunp.thrunp_h, 1);
-            }
-            else
+            if ((r == PERIPHERAL_ROW_ADDRP && !NPZ_CFG_POLLING_HAS_ADDRESS(peripheral->polling_mode)) ||
+                (r >= PERIPHERAL_ROW_RREGP && r <= PERIPHERAL_ROW_THROVP_H &&
+                 !NPZ_CFG_POLLING_HAS_THRESHOLD(peripheral->polling_mode)))
             {
-                printf("Failed to read THRUNP register for peripheral %d \r\n", i + 1);
-                return false;
+                continue;
             }
 
-            // Read and log THROVP register (split into low and high bytes)
-            if (npz_read_THROVP(switches[i], &throvp) == OK)
-            {
-                log_register_data(peripheral_registers[i][9].reg_name, peripheral_registers[i][9].reg_address,
-                                  (uint8_t *) &throvp.throvp_l, 1);
-                log_register_data(peripheral_registers[i][10].reg_name, peripheral_registers[i][10].reg_address,
-                                  (uint8_t *) &throvp.throvp_h, 1);
-            }
-            else
-            {
-                printf("Failed to read THROVP register for peripheral %d \r\n", i + 1);
-                return false;
-            }
-        }
-
-        // Read and log TWTP register
-        if (npz_read_TWTP(switches[i], &twtp) == OK)
-        {
-            log_register_data(peripheral_registers[i][11].reg_name, peripheral_registers[i][11].reg_address,
-                              (uint8_t *) &twtp, sizeof(twtp));
-        }
-        else
-        {
-            printf("Failed to read TWTP register for peripheral %d \r\n", i + 1);
-            return false;
-        }
-
-        // Read and log TCFGP register
-        if (npz_read_TCFGP(switches[i], &tcfgp) == OK)
-        {
-            log_register_data(peripheral_registers[i][12].reg_name, peripheral_registers[i][12].reg_address,
-                              (uint8_t *) &tcfgp, sizeof(tcfgp));
-        }
-        else
-        {
-            printf("Failed to read TCFGP register for peripheral %d \r\n", i + 1);
-            return false;
+            log_register(peripheral_registers[i][r].reg_name, peripheral_registers[i][r].reg_address,
+                         dump->reg[peripheral_registers[i][r].reg_address]);
         }
 
+        log_table_end();
     }
-
-    return true;
 }
 
-static bool adc_config_read(npz_device_config_s *device_config)
+static void log_adc(const npz_device_config_s *device_config, const npz_register_dump_s *dump)
 {
     if (device_config->adc_channels[0]->wakeup_enable == 1)
     {
-        printf("----------------------------------------------\r\n");
-        printf("          Read internal adc registers         \r\n");
-        printf("----------------------------------------------\r\n");
-        printf("[  ADDR |    REGISTER    |     BIN    | HEX  ]\r\n");
-        printf("----------------------------------------------\r\n");
-
-        npz_register_throva1_s throva1 = {0};
-        npz_register_thruna1_s thruna1 = {0};
-
-        if (npz_read_THROVA1(&throva1) != OK)
-        {
-            printf("Failed to read THROVA1 register\r\n");
-            return false;
-        }
-
-        // Log internal ADC over threshold register
-        log_register_data("THROVA1", REG_THROVA1, (uint8_t *) &throva1, sizeof(throva1));
-
-        if (npz_read_THRUNA1(&thruna1) != OK)
-        {
-            printf("Failed to read THRUNA1 register\r\n");
-            return false;
-        }
-
-        // Log internal ADC under threshold register
-        log_register_data("THRUNA1", REG_THRUNA1, (uint8_t *) &thruna1, sizeof(thruna1));
-        printf("----------------------------------------------\r\n");
+        log_table_begin(TABLE_ADC_INTERNAL);
+        log_register("THROVA1", REG_THROVA1, dump->reg[REG_THROVA1]);
+        log_register("THRUNA1", REG_THRUNA1, dump->reg[REG_THRUNA1]);
+        log_table_end();
     }
 
     if (device_config->adc_channels[1]->wakeup_enable == 1 && device_config->adc_ext_sampling_enable == 1)
     {
-        printf("----------------------------------------------\r\n");
-        printf("          Read external adc registers          \r\n");
-        printf("----------------------------------------------\r\n");
-        printf("[  ADDR |    REGISTER    |     BIN    | HEX  ]\r\n");
-        printf("----------------------------------------------\r\n");
+        log_table_begin(TABLE_ADC_EXTERNAL);
+        log_register("THROVA2", REG_THROVA2, dump->reg[REG_THROVA2]);
+        log_register("THRUNA2", REG_THRUNA2, dump->reg[REG_THRUNA2]);
+        log_table_end();
+    }
+}
 
-        npz_register_throva2_s throva2 = {0};
-        npz_register_thruna2_s thruna2 = {0};
+static void log_global(const npz_register_dump_s *dump)
+{
+    log_table_begin(TABLE_GLOBAL);
 
-        if (npz_read_THROVA2(&throva2) != OK)
-        {
-            printf("Failed to read THROVA2 register\r\n");
-            return false;
-        }
+    for (size_t i = 0; i < sizeof(global_register_info) / sizeof(global_register_info[0]); i++)
+    {
+        log_register(global_register_info[i].reg_name, global_register_info[i].reg_address,
+                     dump->reg[global_register_info[i].reg_address]);
+    }
 
-        // Log external ADC over threshold register
-        log_register_data("THROVA2", REG_THROVA2, (uint8_t *) &throva2, sizeof(throva2));
+    log_table_end();
+}
 
-        if (npz_read_THRUNA2(&thruna2) != OK)
-        {
-            printf("Failed to read THRUNA2 register\r\n");
-            return false;
-        }
+static void log_status(const npz_register_dump_s *dump)
+{
+    log_table_begin(TABLE_STATUS);
+    log_register("STA1", REG_STA1, dump->reg[REG_STA1]);
+    log_register("STA2", REG_STA2, dump->reg[REG_STA2]);
+    log_table_end();
+}
 
-        // Log external ADC under threshold register
-        log_register_data("THRUNA2", REG_THRUNA2, (uint8_t *) &thruna2, sizeof(thruna2));
+/**
+ * @brief Whether a register holds configuration, as opposed to a command, status or measured value.
+ */
+static bool is_configuration(uint8_t address)
+{
+    if (address >= REG_SRAM_START)
+    {
+        return true;
     }
 
-    printf("----------------------------------------------\r\n");
-
-    return true;
+    return address != REG_SLEEP_RST && address != REG_STA1 && address != REG_STA2 && address < REG_VALP1_L;
 }
 
-static bool validate_peripherals(npz_device_config_s *device_config)
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_status_e npz_dump_registers(npz_register_dump_s *dump)
 {
-    m_configured_count = 0; // Reset count for each validation
+    if (dump == NULL)
+    {
+        return INVALID_PARAM;
+    }
 
-    for (int i = 0; i < 4; i++)
+    if (npz_read_register(REG_SLEEP_RST, dump->reg, sizeof(dump->reg)) != OK)
     {
-        // Check if peripheral configuration is not NULL
-        if (device_config->peripherals[i] != NULL)
-        {
-            m_configured_indices[m_configured_count++] = i;
-        }
+        return ERR;
     }
 
-    return true;
+    return npz_read_register(REG_SRAM_START, dump->sram, sizeof(dump->sram));
 }
 
-static bool peripheral_config_read(npz_device_config_s *device_config)
+uint8_t npz_dump_value(const npz_register_dump_s *dump, uint8_t address)
 {
-    // Validate peripherals
-    if (validate_peripherals(device_config))
+    if (address >= REG_SRAM_START)
     {
-        // Configure peripherals
-        if (!read_peripherals(device_config))
-        {
-            printf("Failed to read peripherals\r\n");
-            return false;
-        }
+        return dump->sram[address - REG_SRAM_START];
     }
 
-    return true;
+    return (address < sizeof(dump->reg)) ? dump->reg[address] : 0;
 }
 
-static bool global_config_read()
+npz_status_e npz_verify_against(const npz_device_config_s *device_config, const npz_register_dump_s *dump,
+                                npz_mismatch_s *mismatches, uint8_t max, uint8_t *count)
 {
-    uint8_t data;        // Buffer to store data read from registers
-    char binary_str[9];  // Buffer to hold binary strings for each register value
-    npz_status_e status; // Variable to hold the status of I2C read
-
-    printf("----------------------------------------------\n\r");
-    printf("          Read global registers               \n\r");
-    printf("----------------------------------------------\n\r");
-    printf("[  ADDR |    REGISTER    |     BIN    | HEX  ]\n\r");
-    printf("----------------------------------------------\n\r");
+    npz_image_s image;
+    npz_status_e status;
+    uint8_t found = 0;
 
-    // Iterate over the register_info array to read and log each register
-    for (size_t i = 0; i < sizeof(global_register_info) / sizeof(global_register_info[0]); i++)
+    if (device_config == NULL || dump == NULL || count == NULL || (mismatches == NULL && max != 0))
     {
-        // Read the register value using the generic read function
-        status = npz_read_register(global_register_info[i].reg_address, &data, 1);
-        if (status != OK)
-        {
-            printf("Failed to read register at address 0x%02X \n\r", global_register_info[i].reg_address);
-            return false;
-        }
-
-        // Convert the register value to a binary string for logging
-        char_to_binary_string(data, binary_str);
-
-
-        printf("[  %02X   | %-14s | %-10s | 0x%02X ] \n\r", global_register_info[i].reg_address,
-                global_register_info[i].reg_name, binary_str, data);
+        return INVALID_PARAM;
     }
 
-    printf("----------------------------------------------");
-
-    return true;
-}
+    *count = 0;
 
-
-static bool read_status_registers(void)
-{
-    npz_register_sta1_s status1 = {0}; // Variable to store status1 register values
-    npz_register_sta2_s status2 = {0}; // Variable to store status2 register values
-
-    // Read the first status register
-    if (npz_read_STA1(&status1) != OK)
+    npz_capture_begin(&image);
+    status = npz_device_configure(device_config);
+    if (npz_capture_end() != OK && status == OK)
     {
-        return false;
+        status = ERR;
     }
 
-    // Read the second status register
-    if (npz_read_STA2(&status2) != OK)
+    if (status != OK)
     {
-        return false;
+        return status;
     }
 
-    // Log the registers
-    printf("----------------------------------------------\n\r");
-    printf("          Read status registers               \n\r");
-    printf("----------------------------------------------\n\r");
-    printf("[  ADDR |    REGISTER    |     BIN    | HEX  ]\n\r");
-    printf("----------------------------------------------\n\r");
+    for (uint16_t i = 0; i < image.count; i++)
+    {
+        uint8_t address = image.reg[i];
+        uint8_t actual = npz_dump_value(dump, address);
+        bool superseded = false;
 
-    // Log STA1 register
-    char binary_str[9];
-    char_to_binary_string(*((uint8_t *) &status1), binary_str); // Use the address to cast
-    printf("[  %02X   | %-14s | %-10s | 0x%02X ]\n\r", REG_STA1, "STA1", binary_str, *((uint8_t *) &status1));
+        if (!is_configuration(address))
+        {
+            continue;
+        }
 
-    // Log STA2 register
-    char_to_binary_string(*((uint8_t *) &status2), binary_str); // Use the address to cast
-    printf("[  %02X   | %-14s | %-10s | 0x%02X ]\n\r", REG_STA2, "STA2", binary_str, *((uint8_t *) &status2));
+        // Only the last write to an address is what the device should hold
+        for (uint16_t j = i + 1; j < image.count && !superseded; j++)
+        {
+            superseded = (image.reg[j] == address);
+        }
+
+        if (superseded || actual == image.value[i])
+        {
+            continue;
+        }
 
-    printf("----------------------------------------------");
+        if (found < max)
+        {
+            mismatches[found].reg = address;
+            mismatches[found].expected = image.value[i];
+            mismatches[found].actual = actual;
+        }
 
-    return true;
-}
+        if (found < UINT8_MAX)
+        {
+            found++;
+        }
+    }
 
+    *count = found;
 
-/*****************************************************************************
- * Public Methods
- *****************************************************************************/
+    return (found == 0) ? OK : ERR;
+}
 
-void npz_log_configurations(npz_device_config_s *device_config)
+void npz_log_configurations(const npz_device_config_s *device_config)
 {
-    if (!global_config_read())
-    {
-        printf("Failed to read configure global settings");
-        return;
-    }
+    npz_register_dump_s dump;
 
-    if (!read_status_registers())
+    // Everything is read before anything is printed, so the bus is busy for two transfers only
+    if (npz_dump_registers(&dump) != OK)
     {
-		printf("Failed to read status registers \n\r");
-		return;
-	}
-
-    if (!peripheral_config_read(device_config))
-    {
-        printf("Failed to read peripherals configuration \n\r");
+        NPZ_LOG_ERROR("Failed to read the registers\r\n");
         return;
     }
 
-    if (!adc_config_read(device_config))
-    {
-        printf("Failed to read ADC configuration \n\r");
-        return;
-    }
+    log_global(&dump);
+    log_status(&dump);
+    log_peripherals(device_config, &dump);
+    log_adc(device_config, &dump);
 }
@@ -0,0 +1,96 @@
+/**
+ * @file npz_report.c
+ * @brief Implementation of the binary wake report.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+static uint8_t *put_u16(uint8_t *out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+
+    return out + 2;
+}
+
+static uint8_t *put_u32(uint8_t *out, uint32_t value)
+{
+    out = put_u16(out, (uint16_t)value);
+
+    return put_u16(out, (uint16_t)(value >> 16));
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_report_fill(npz_report_s *report, const npz_wake_s *wake, uint32_t wake_count, const npz_time_s *time)
+{
+    report->reset_source = wake->sta1.reset_source;
+    report->events = wake->events;
+    memcpy(report->valp, wake->valp, sizeof(report->valp));
+    report->adc_core = wake->adc_core;
+    report->adc_ext = wake->adc_ext;
+    report->wake_count = wake_count;
+    report->seconds = time->seconds;
+    report->millis = time->millis;
+}
+
+void npz_report_encode(const npz_report_s *report, uint8_t *payload)
+{
+    uint8_t *out = payload;
+
+    *out++ = NPZ_REPORT_RECORD;
+    *out++ = NPZ_REPORT_VERSION;
+    *out++ = report->reset_source;
+    out = put_u16(out, report->events);
+
+    for (int i = 0; i < 4; i++)
+    {
+        out = put_u16(out, report->valp[i]);
+    }
+
+    *out++ = report->adc_core;
+    *out++ = report->adc_ext;
+    out = put_u32(out, report->wake_count);
+    out = put_u32(out, report->seconds);
+    out = put_u16(out, report->millis);
+    put_u16(out, npz_crc16(NPZ_CRC16_INIT, payload, (size_t)(out - payload)));
+}
+
+npz_status_e npz_report_send(const npz_wake_s *wake, uint32_t wake_count, const npz_time_s *time)
+{
+    npz_report_s report;
+    uint8_t payload[NPZ_REPORT_SIZE];
+    uint8_t frame[NPZ_COBS_MAX_ENCODED(NPZ_REPORT_SIZE) + 2];
+    size_t length;
+
+    if (wake == NULL || time == NULL)
+    {
+        return INVALID_PARAM;
+    }
+
+    npz_report_fill(&report, wake, wake_count, time);
+    npz_report_encode(&report, payload);
+
+    // Delimited on both sides, so text printed just before is not taken as part of the frame
+    frame[0] = NPZ_COBS_DELIMITER;
+    length = npz_cobs_encode(payload, sizeof(payload), &frame[1]) + 1;
+    frame[length++] = NPZ_COBS_DELIMITER;
+
+    // Half a frame would only cost the collector a CRC error, keep the space for the output that follows
+    if (NPZ_CONSOLE_POLICY == NPZ_CONSOLE_DROP_NEW && npz_console_free() < length)
+    {
+        return ERR;
+    }
+
+    return (npz_console_write(frame, length) == length) ? OK : ERR;
+}
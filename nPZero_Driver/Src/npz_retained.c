@@ -0,0 +1,93 @@
+/**
+ * @file npz_retained.c
+ * @brief Implementation of the retained state store in the device SRAM tail.
+ *
+ * Layout: struct size, CRC low byte, CRC high byte, struct bytes. The CRC covers the size byte and the struct, so
+ * a struct whose layout changed size is rejected as well.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define AREA_SIZE (NPZ_RETAINED_HEADER_SIZE + NPZ_RETAINED_MAX_DATA)
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+static uint16_t area_crc(uint8_t size, const void *data)
+{
+    return npz_crc16(npz_crc16(NPZ_CRC16_INIT, &size, 1), data, size);
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_status_e npz_retained_load(void *data, uint8_t size)
+{
+    uint8_t area[AREA_SIZE];
+    uint16_t crc;
+
+    if (data == NULL || size == 0 || size > NPZ_RETAINED_MAX_DATA)
+    {
+        return INVALID_PARAM;
+    }
+
+    // Header and struct in one burst
+    if (npz_read_register(NPZ_RETAINED_ADDRESS, area, NPZ_RETAINED_HEADER_SIZE + size) != OK)
+    {
+        return ERR;
+    }
+
+    crc = (uint16_t)(area[1] | (area[2] << 8));
+
+    if (area[0] != size || crc != area_crc(size, &area[NPZ_RETAINED_HEADER_SIZE]))
+    {
+        return ERR;
+    }
+
+    memcpy(data, &area[NPZ_RETAINED_HEADER_SIZE], size);
+
+    return OK;
+}
+
+npz_status_e npz_retained_save(const void *data, uint8_t size)
+{
+    uint8_t area[AREA_SIZE];
+    uint16_t crc;
+
+    if (data == NULL || size == 0 || size > NPZ_RETAINED_MAX_DATA)
+    {
+        return INVALID_PARAM;
+    }
+
+    crc = area_crc(size, data);
+
+    area[0] = size;
+    area[1] = (uint8_t)crc;
+    area[2] = (uint8_t)(crc >> 8);
+    memcpy(&area[NPZ_RETAINED_HEADER_SIZE], data, size);
+
+    return npz_write_SRAM_block(NPZ_RETAINED_ADDRESS, area, NPZ_RETAINED_HEADER_SIZE + size);
+}
+
+npz_status_e npz_retained_invalidate(void)
+{
+    // A zero size never passes npz_retained_load()
+    static const uint8_t empty[NPZ_RETAINED_HEADER_SIZE] = {0};
+
+    if (NPZ_RETAINED_MAX_DATA == 0)
+    {
+        return INVALID_PARAM;
+    }
+
+    return npz_write_SRAM_block(NPZ_RETAINED_ADDRESS, empty, sizeof(empty));
+}
@@ -0,0 +1,209 @@
+/**
+ * @file npz_sensor_codec.c
+ * @brief Codecs of the DevKit sensors and the peripheral configuration builder.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+/* AS6212: configuration register 0x01 = 0x82, register 0x02 = 0xA0 */
+static const uint8_t m_as6212_init_sequence[] = {0x01, 0x82, 0x02, 0xA0};
+
+/* Accelerometer: write 0x10 to CTRL_REG1, then read OUT_X_L/OUT_X_H (read bit set) */
+static const uint8_t m_accel_init_sequence[] = {0x20, 0x10};
+static const uint8_t m_accel_read_sequence[] = {0xA8};
+
+const npz_sensor_codec_s npz_sensor_as6212 = {
+    .name = "AS6212",
+    .unit = "degC",
+    .decimals = 3,
+    .protocol = COM_I2C,
+    .data_type = DATA_TYPE_INT16,
+    .endianness = ENDIAN_BIG,
+    .multi_byte_transfer = MULTIBYTE_TRANSFER_ENABLE,
+    .init_sequence = m_as6212_init_sequence,
+    .init_sequence_num = sizeof(m_as6212_init_sequence),
+    .read_register = 0x00,
+    .default_address = 0x49,
+    .conversion = &npz_convert_as6212_temperature,
+};
+
+const npz_sensor_codec_s npz_sensor_devkit_accel = {
+    .name = "Accelerometer X",
+    .unit = "g",
+    .decimals = 3,
+    .protocol = COM_SPI,
+    .data_type = DATA_TYPE_INT16,
+    .endianness = ENDIAN_LITTLE,
+    .multi_byte_transfer = MULTIBYTE_TRANSFER_DISABLE,
+    .init_sequence = m_accel_init_sequence,
+    .init_sequence_num = sizeof(m_accel_init_sequence),
+    .read_sequence = m_accel_read_sequence,
+    .read_sequence_num = sizeof(m_accel_read_sequence),
+    .spi_mode = SPIMOD_SPI_MODE_0,
+    .conversion = &npz_convert_accel_2g,
+    // No block, the host has no SPI port on this board to read Y and Z itself
+};
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Tells if the power switch of a peripheral is on while the host is awake.
+ */
+static bool is_powered(const npz_device_config_s *device, int index)
+{
+    switch (index)
+    {
+        case 0:
+            return device->power_switch_normal_mode_per1;
+        case 1:
+            return device->power_switch_normal_mode_per2;
+        case 2:
+            return device->power_switch_normal_mode_per3;
+        case 3:
+            return device->power_switch_normal_mode_per4;
+        default:
+            return false;
+    }
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_status_e npz_sensor_build_config(const npz_sensor_codec_s *codec, const npz_sensor_params_s *params,
+                                     npz_peripheral_config_s *config)
+{
+    if (codec == NULL || params == NULL || config == NULL || codec->conversion == NULL)
+    {
+        return INVALID_PARAM;
+    }
+
+    if (!NPZ_CFG_PROTOCOL_ENABLED(codec->protocol))
+    {
+        return INVALID_PARAM;
+    }
+
+    memset(config, 0, sizeof(*config));
+
+    config->communication_protocol = codec->protocol;
+    config->power_mode = params->power_mode;
+    config->polling_mode = params->polling_mode;
+    config->power_switch_mode = params->power_switch_mode;
+    config->interrupt_pin_mode = params->interrupt_pin_mode;
+    config->comparison_mode = params->comparison_mode;
+    config->sensor_data_type = codec->data_type;
+    config->multi_byte_transfer_enable = codec->multi_byte_transfer;
+    config->swap_registers = codec->endianness;
+    config->polling_period = params->polling_period;
+    config->threshold_over = npz_sensor_threshold(codec, params->threshold_over_milli);
+    config->threshold_under = npz_sensor_threshold(codec, params->threshold_under_milli);
+    config->time_to_wait = params->time_to_wait;
+    config->pre_wait_time = params->pre_wait_time;
+    config->post_wait_time = params->post_wait_time;
+
+    if (codec->protocol == COM_I2C)
+    {
+        config->i2c_cfg.sensor_address = params->i2c_address ? params->i2c_address : codec->default_address;
+        config->i2c_cfg.command_num = codec->init_sequence_num / 2;
+        config->i2c_cfg.bytes_from_sram = codec->init_sequence;
+        config->i2c_cfg.reg_address_value = codec->read_register;
+        config->i2c_cfg.wake_on_nak = params->wake_on_nak;
+        config->i2c_cfg.num_of_retries_on_nak = params->num_of_retries_on_nak;
+    }
+    else
+    {
+        config->spi_cfg.bytes_from_sram_num = codec->init_sequence_num;
+        config->spi_cfg.bytes_from_sram = codec->init_sequence;
+        config->spi_cfg.bytes_from_sram_read_num = codec->read_sequence_num;
+        config->spi_cfg.bytes_from_sram_read = codec->read_sequence;
+        config->spi_cfg.mode = codec->spi_mode;
+    }
+
+    return OK;
+}
+
+uint16_t npz_sensor_threshold(const npz_sensor_codec_s *codec, int32_t milli)
+{
+    const npz_convert_s *conversion = codec->conversion;
+    int64_t scaled = ((int64_t)milli - conversion->offset_milli) * 65536;
+    int64_t half = conversion->scale_q16 / 2;
+    int64_t raw;
+    int32_t low;
+    int32_t high;
+
+    // Inverse of npz_convert_milli(), rounded half away from zero
+    raw = (scaled + (scaled < 0 ? -half : half)) / conversion->scale_q16;
+
+    switch (codec->data_type)
+    {
+        case DATA_TYPE_INT16:
+            low = INT16_MIN;
+            high = INT16_MAX;
+            break;
+        case DATA_TYPE_UINT8:
+            low = 0;
+            high = UINT8_MAX;
+            break;
+        default:
+            low = 0;
+            high = UINT16_MAX;
+            break;
+    }
+
+    if (raw < low)
+    {
+        raw = low;
+    }
+    else if (raw > high)
+    {
+        raw = high;
+    }
+
+    // Signed thresholds are stored as their two's complement bit pattern
+    return (uint16_t)raw;
+}
+
+int32_t npz_sensor_decode(const npz_sensor_codec_s *codec, uint16_t raw)
+{
+    return npz_convert_milli(codec->conversion, raw);
+}
+
+npz_status_e npz_sensor_read_block(const npz_sensor_codec_s *codec, const npz_device_config_s *device, int index,
+                                   uint8_t *data, uint8_t size)
+{
+    const npz_peripheral_config_s *config;
+
+    if (codec == NULL || device == NULL || data == NULL || index < 0 || index >= 4)
+    {
+        return INVALID_PARAM;
+    }
+
+    config = device->peripherals[index];
+
+    if (config == NULL || codec->protocol != COM_I2C || codec->block_size == 0 || size < codec->block_size ||
+        !is_powered(device, index))
+    {
+        return INVALID_PARAM;
+    }
+
+    return npz_hal_read((uint8_t)(config->i2c_cfg.sensor_address << 1), config->i2c_cfg.reg_address_value, data,
+                        codec->block_size, I2C_TRANSMISSION_TIMEOUT_MS);
+}
+
+uint16_t npz_sensor_block_value(const npz_sensor_codec_s *codec, const uint8_t *block, uint8_t n)
+{
+    const uint8_t *bytes = &block[2 * n];
+
+    return (codec->endianness == ENDIAN_BIG) ? (uint16_t)((bytes[0] << 8) | bytes[1]) :
+                                               (uint16_t)((bytes[1] << 8) | bytes[0]);
+}
@@ -0,0 +1,418 @@
+/**
+ * @file npz_shell.c
+ * @brief Implementation of the register shell.
+ *
+ * The receive callback of the HAL collects one byte at a time into the line buffer. npz_shell_run()
+ * waits for a complete line and executes it outside the interrupt, so bus transfers never run in interrupt context.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define DATA_SIZE (NPZ_SHELL_LINE_SIZE / 2) /**< Every written value takes at least two characters. */
+#define ROW_VALUES 16                        /**< Values per row of read output. */
+#define ROW_SIZE   (4 + ROW_VALUES * 3 + 2)  /**< "80:", the values and CR LF. */
+
+/*****************************************************************************
+ * Types
+ *****************************************************************************/
+
+typedef enum
+{
+    COMMAND_READ,
+    COMMAND_WRITE,
+    COMMAND_APPLY,
+    COMMAND_SLEEP,
+} command_type_e;
+
+/** One parsed command. Values of writes are kept in m_data, in the order of the commands. */
+typedef struct
+{
+    command_type_e type;
+    uint8_t reg;     /**< First register. */
+    uint16_t count;  /**< Registers read or written, at most up to REG_SRAM_END. */
+    uint16_t offset; /**< Index of the first value in m_data, writes only. */
+} command_s;
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+static command_s m_commands[NPZ_SHELL_MAX_COMMANDS];
+static uint8_t m_data[DATA_SIZE];
+static uint8_t m_burst[REG_SRAM_END + 1]; /**< Values of one coalesced read. */
+
+static char m_line[NPZ_SHELL_LINE_SIZE + 1];
+static volatile uint16_t m_length;
+static volatile bool m_ready;      /**< A complete line waits in m_line, further input is dropped until it is run. */
+static volatile bool m_overflow;   /**< The line did not fit. */
+static volatile uint32_t m_last_rx; /**< npz_hal_get_ms() at the last byte received. */
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Receive callback of the HAL, called from the receive and error interrupts.
+ */
+static void on_receive(uint8_t byte, bool ok)
+{
+    char c = (char)byte;
+
+    m_last_rx = npz_hal_get_ms();
+
+    // A byte with a framing or parity error is not worth keeping
+    if (ok && !m_ready)
+    {
+        if (c == '\r' || c == '\n')
+        {
+            // Empty lines, such as the LF of a CR LF, are ignored
+            m_ready = (m_length > 0) || m_overflow;
+        }
+        else if (c == '\b' || c == 0x7F)
+        {
+            if (m_length > 0)
+            {
+                m_length--;
+            }
+        }
+        else if (m_length < NPZ_SHELL_LINE_SIZE)
+        {
+            m_line[m_length++] = c;
+        }
+        else
+        {
+            m_overflow = true;
+        }
+    }
+}
+
+/**
+ * @brief Waits for space in the console buffer, so long output is not dropped.
+ */
+static void reserve(size_t size)
+{
+    uint32_t start = npz_hal_get_ms();
+
+    npz_console_kick();
+
+    while (npz_console_free() < size && npz_hal_uart_is_on() &&
+           (npz_hal_get_ms() - start) < NPZ_SHELL_REPLY_TIMEOUT_MS)
+    {
+    }
+}
+
+static void respond(const char *text)
+{
+    size_t length = strlen(text);
+
+    reserve(length);
+    npz_console_write(text, length);
+}
+
+/**
+ * @brief Prints register values, ROW_VALUES per row, each row prefixed with the address of its first value.
+ */
+static void print_values(uint8_t reg, const uint8_t *values, uint16_t count)
+{
+    char row[ROW_SIZE + 1];
+
+    for (uint16_t i = 0; i < count; i += ROW_VALUES)
+    {
+        int length = snprintf(row, sizeof(row), "%02X:", (unsigned)(reg + i));
+
+        for (uint16_t j = i; j < count && j < i + ROW_VALUES; j++)
+        {
+            length += snprintf(&row[length], sizeof(row) - (size_t)length, " %02X", values[j]);
+        }
+
+        snprintf(&row[length], sizeof(row) - (size_t)length, "\r\n");
+        respond(row);
+    }
+}
+
+static char *skip_spaces(char *text)
+{
+    while (*text == ' ' || *text == '\t')
+    {
+        text++;
+    }
+
+    return text;
+}
+
+/**
+ * @brief Parses the next hexadecimal number of a command.
+ *
+ * @return False if there is none or it exceeds max.
+ */
+static bool parse_number(char **text, uint32_t max, uint32_t *value)
+{
+    char *start = skip_spaces(*text);
+    char *end;
+    unsigned long number = strtoul(start, &end, 16);
+
+    if (end == start || number > max)
+    {
+        return false;
+    }
+
+    *text = end;
+    *value = (uint32_t)number;
+
+    return true;
+}
+
+/**
+ * @brief Parses one command into m_commands[index], values of writes go to m_data from *used on.
+ */
+static bool parse_command(char *text, uint8_t index, uint16_t *used)
+{
+    command_s *command = &m_commands[index];
+    char *word = skip_spaces(text);
+    size_t length = strcspn(word, " \t");
+    char *args = word + length;
+    uint32_t value;
+
+    command->offset = *used;
+
+    if (length == 1 && word[0] == 'r')
+    {
+        command->type = COMMAND_READ;
+
+        if (!parse_number(&args, REG_SRAM_END, &value))
+        {
+            return false;
+        }
+
+        command->reg = (uint8_t)value;
+        command->count = 1;
+
+        if (*skip_spaces(args) != '\0')
+        {
+            if (!parse_number(&args, REG_SRAM_END + 1 - command->reg, &value) || value == 0)
+            {
+                return false;
+            }
+
+            command->count = (uint16_t)value;
+        }
+    }
+    else if (length == 1 && word[0] == 'w')
+    {
+        command->type = COMMAND_WRITE;
+        command->count = 0;
+
+        if (!parse_number(&args, REG_SRAM_END, &value))
+        {
+            return false;
+        }
+
+        command->reg = (uint8_t)value;
+
+        while (*skip_spaces(args) != '\0')
+        {
+            if (*used >= DATA_SIZE || command->reg + command->count > REG_SRAM_END ||
+                !parse_number(&args, UINT8_MAX, &value))
+            {
+                return false;
+            }
+
+            m_data[(*used)++] = (uint8_t)value;
+            command->count++;
+        }
+
+        if (command->count == 0)
+        {
+            return false;
+        }
+    }
+    else if (length == 8 && strncmp(word, "snapshot", length) == 0)
+    {
+        command->type = COMMAND_READ;
+        command->reg = REG_SLEEP_RST;
+        command->count = NPZ_DUMP_REGISTER_COUNT;
+    }
+    else if (length == 4 && strncmp(word, "sram", length) == 0)
+    {
+        command->type = COMMAND_READ;
+        command->reg = REG_SRAM_START;
+        command->count = NPZ_DUMP_SRAM_SIZE;
+    }
+    else if (length == 5 && strncmp(word, "apply", length) == 0)
+    {
+        command->type = COMMAND_APPLY;
+    }
+    else if (length == 5 && strncmp(word, "sleep", length) == 0)
+    {
+        command->type = COMMAND_SLEEP;
+    }
+    else
+    {
+        return false;
+    }
+
+    return *skip_spaces(args) == '\0';
+}
+
+/**
+ * @brief Number of reads after first that continue its transfer, with the registers they add in *count.
+ *
+ * Writes are not merged, they go one register per transfer anyway and each reports its own failure.
+ */
+static uint8_t coalesce(uint8_t first, uint8_t total, uint16_t *count)
+{
+    const command_s *start = &m_commands[first];
+    uint8_t next = first + 1;
+
+    *count = start->count;
+
+    if (start->type != COMMAND_READ)
+    {
+        return 0;
+    }
+
+    while (next < total && m_commands[next].type == COMMAND_READ && m_commands[next].reg == start->reg + *count)
+    {
+        *count += m_commands[next].count;
+        next++;
+    }
+
+    return (uint8_t)(next - first - 1);
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+bool npz_shell_execute(char *line, const npz_device_config_s *device_config)
+{
+    char text[16];
+    uint16_t used = 0;
+    uint8_t total = 0;
+    bool sleep = false;
+    char *next;
+
+    // Parse everything first, a line with a typo must not leave half of its writes done
+    while (line != NULL)
+    {
+        next = strchr(line, ';');
+
+        if (next != NULL)
+        {
+            *next++ = '\0';
+        }
+
+        // Empty commands, e.g. after a trailing ';', are skipped
+        if (*skip_spaces(line) != '\0')
+        {
+            if (total >= NPZ_SHELL_MAX_COMMANDS || !parse_command(line, total, &used))
+            {
+                snprintf(text, sizeof(text), "ERR %u\r\n", total + 1);
+                respond(text);
+                return false;
+            }
+
+            total++;
+        }
+
+        line = next;
+    }
+
+    for (uint8_t i = 0; i < total; i++)
+    {
+        const command_s *command = &m_commands[i];
+        uint16_t count;
+        uint8_t extra = coalesce(i, total, &count);
+        npz_status_e status = OK;
+
+        switch (command->type)
+        {
+        case COMMAND_READ:
+            status = npz_read_register(command->reg, m_burst, count);
+            break;
+
+        case COMMAND_WRITE:
+            status = npz_write_register(command->reg, &m_data[command->offset], count);
+            break;
+
+        case COMMAND_APPLY:
+            status = (device_config != NULL) ? npz_device_configure(device_config) : INVALID_PARAM;
+            break;
+
+        case COMMAND_SLEEP:
+            sleep = true;
+            break;
+        }
+
+        if (status != OK)
+        {
+            snprintf(text, sizeof(text), "ERR %u\r\n", i + 1);
+            respond(text);
+            return false;
+        }
+
+        // Every read of the run answers with its own slice of the transfer
+        for (uint8_t j = i; j <= i + extra && command->type == COMMAND_READ; j++)
+        {
+            print_values(m_commands[j].reg, &m_burst[m_commands[j].reg - command->reg], m_commands[j].count);
+        }
+
+        i += extra;
+    }
+
+    respond("OK\r\n");
+
+    return sleep;
+}
+
+npz_status_e npz_shell_run(const npz_device_config_s *device_config, uint32_t idle_timeout)
+{
+    bool sleep = false;
+
+    m_length = 0;
+    m_overflow = false;
+    m_ready = false;
+    m_last_rx = npz_hal_get_ms();
+
+    if (!npz_hal_uart_receive_start(on_receive))
+    {
+        return INVALID_PARAM;
+    }
+
+    while (!sleep && (npz_hal_get_ms() - m_last_rx) < idle_timeout)
+    {
+        if (!m_ready)
+        {
+            continue;
+        }
+
+        if (m_overflow)
+        {
+            respond("ERR 0\r\n");
+        }
+        else
+        {
+            m_line[m_length] = '\0';
+            sleep = npz_shell_execute(m_line, device_config);
+        }
+
+        // The receive callback leaves the line alone until m_ready is cleared
+        m_length = 0;
+        m_overflow = false;
+        m_last_rx = npz_hal_get_ms();
+        m_ready = false;
+    }
+
+    npz_hal_uart_receive_stop();
+    npz_console_drain(NPZ_SHELL_REPLY_TIMEOUT_MS);
+
+    return OK;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file npz_stats.c
+ * @brief Implementation of the streaming statistics.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Divides and rounds to nearest, halves away from zero.
+ */
+static int64_t divide_rounded(int64_t numerator, int64_t denominator)
+{
+    int64_t half = denominator / 2;
+
+    return (numerator + ((numerator < 0) ? -half : half)) / denominator;
+}
+
+/**
+ * @brief Integer square root, rounded down.
+ */
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+/**
+ * @brief Variance in Q8, 0 for fewer than two values.
+ */
+static uint64_t variance_q8(const npz_stats_s *stats)
+{
+    if (stats->count < 2 || stats->m2_q8 <= 0)
+    {
+        return 0;
+    }
+
+    return (uint64_t)stats->m2_q8 / (stats->count - 1);
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_stats_reset(npz_stats_s *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+void npz_stats_add(npz_stats_s *stats, int32_t value)
+{
+    int32_t value_q8 = value * 256;
+    int32_t delta_q8;
+
+    if (stats->count == 0)
+    {
+        stats->min = value;
+        stats->max = value;
+    }
+    else if (value < stats->min)
+    {
+        stats->min = value;
+    }
+    else if (value > stats->max)
+    {
+        stats->max = value;
+    }
+
+    // Past the saturation point new values weigh as the last one counted
+    if (stats->count < UINT16_MAX)
+    {
+        stats->count++;
+    }
+
+    // Welford: move the mean by delta / n, then grow M2 by delta times the distance to the new mean
+    delta_q8 = value_q8 - stats->mean_q8;
+    stats->mean_q8 += (int32_t)divide_rounded(delta_q8, stats->count);
+    stats->m2_q8 += ((int64_t)delta_q8 * (value_q8 - stats->mean_q8)) / 256;
+}
+
+void npz_stats_add_wake(npz_stats_s stats[4], const npz_wake_s *wake)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (wake->events & (NPZ_EVENT_PER1_TRIGGER << i))
+        {
+            npz_stats_add(&stats[i], wake->value[i]);
+        }
+    }
+}
+
+int32_t npz_stats_mean(const npz_stats_s *stats)
+{
+    return (int32_t)divide_rounded(stats->mean_q8, 256);
+}
+
+uint32_t npz_stats_variance(const npz_stats_s *stats)
+{
+    uint64_t variance = (variance_q8(stats) + 128) / 256;
+
+    return (variance > UINT32_MAX) ? UINT32_MAX : (uint32_t)variance;
+}
+
+uint32_t npz_stats_stddev(const npz_stats_s *stats)
+{
+    // sqrt of the Q8 variance shifted to Q16 gives the deviation in Q8
+    uint32_t stddev_q8 = isqrt64(variance_q8(stats) << 8);
+
+    return (stddev_q8 + 128) / 256;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file npz_time.c
+ * @brief Implementation of the elapsed time reconstruction.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define CLOCK_10HZ_HZ  10
+#define CLOCK_32KHZ_HZ 32578
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+static uint64_t to_ms(const npz_time_s *time)
+{
+    return (uint64_t)time->seconds * 1000 + time->millis;
+}
+
+static void add_ms(npz_time_s *time, uint64_t ms, uint64_t error_ms)
+{
+    uint64_t total = to_ms(time) + ms;
+
+    time->seconds = (uint32_t)(total / 1000);
+    time->millis = (uint16_t)(total % 1000);
+
+    if (time->error_ms != NPZ_TIME_ERROR_UNKNOWN)
+    {
+        error_ms += time->error_ms;
+        time->error_ms = (error_ms >= NPZ_TIME_ERROR_UNKNOWN) ? NPZ_TIME_ERROR_UNKNOWN : (uint32_t)error_ms;
+    }
+}
+
+/**
+ * @brief Earliest possible trigger of a peripheral, in system clock periods after sleep started.
+ */
+static uint32_t earliest_trigger(const npz_peripheral_config_s *peripheral)
+{
+    // An interrupt can come in at any time, a polled value only at the end of a polling period
+    if (peripheral == NULL || peripheral->polling_mode == POLLING_MODE_ASYNC_WAIT_INTERRUPT)
+    {
+        return 0;
+    }
+
+    return peripheral->polling_period;
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_time_reset(npz_time_s *time)
+{
+    time->seconds = 0;
+    time->millis = 0;
+    time->error_ms = 0;
+}
+
+void npz_time_add_awake(npz_time_s *time, uint32_t awake_ms)
+{
+    // The host starts measuring a little after it was powered
+    add_ms(time, awake_ms, 1);
+}
+
+uint32_t npz_time_ticks_to_ms(const npz_device_config_s *config, uint32_t ticks)
+{
+    uint32_t frequency = (config->system_clock_source == SYS_CLOCK_32KHZ) ? CLOCK_32KHZ_HZ : CLOCK_10HZ_HZ;
+
+    // SCLK_DIV_2 to SCLK_DIV_16 are 2n - 1 for a division by 2^n
+    uint32_t divider = (config->system_clock_divider == SCLK_DIV_DISABLE) ?
+        1 : (1U << ((config->system_clock_divider + 1) / 2));
+
+    return (uint32_t)(((uint64_t)ticks * divider * 1000 + frequency / 2) / frequency);
+}
+
+void npz_time_on_wake(npz_time_s *time, const npz_device_config_s *config, const npz_wake_s *wake)
+{
+    uint32_t tick_ms;
+    uint32_t earliest;
+    uint32_t latest;
+
+    if (config == NULL || (wake->events & NPZ_EVENT_RESET) || config->global_timeout == 0)
+    {
+        time->error_ms = NPZ_TIME_ERROR_UNKNOWN;
+        return;
+    }
+
+    // The sleep timer runs on the system clock, so every bound is off by up to one period
+    tick_ms = npz_time_ticks_to_ms(config, 1);
+    tick_ms = (tick_ms == 0) ? 1 : tick_ms;
+    latest = config->global_timeout;
+
+    if (wake->events & NPZ_EVENT_GLOBAL_TIMEOUT)
+    {
+        add_ms(time, npz_time_ticks_to_ms(config, latest), tick_ms);
+        return;
+    }
+
+    if (wake->events & (NPZ_EVENT_ADC_INTERNAL | NPZ_EVENT_ADC_EXTERNAL))
+    {
+        earliest = 0;
+    }
+    else
+    {
+        // With WAKEUP_ANY the first trigger woke the host, with WAKEUP_ALL the last one did
+        earliest = (config->wake_up_any_or_all == WAKEUP_ANY) ? latest : 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            uint32_t trigger;
+
+            if (!(wake->events & (NPZ_EVENT_PER1_TRIGGER << i)))
+            {
+                continue;
+            }
+
+            trigger = earliest_trigger(config->peripherals[i]);
+
+            if (config->wake_up_any_or_all == WAKEUP_ANY ? (trigger < earliest) : (trigger > earliest))
+            {
+                earliest = trigger;
+            }
+        }
+
+        if (earliest > latest)
+        {
+            earliest = latest;
+        }
+    }
+
+    add_ms(time, npz_time_ticks_to_ms(config, (earliest + latest) / 2),
+           (uint64_t)npz_time_ticks_to_ms(config, (latest - earliest + 1) / 2) + tick_ms);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file npz_token.c
+ * @brief Implementation of the tokenized log output.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define RECORD_TOKEN 0x04
+
+/** Type, token and the longest varint of each argument. */
+#define PAYLOAD_MAX (3 + NPZ_TOKEN_MAX_ARGS * 5)
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+void npz_token_send(uint16_t token, const uint32_t *args, size_t count)
+{
+    uint8_t payload[PAYLOAD_MAX];
+    uint8_t frame[NPZ_COBS_MAX_ENCODED(PAYLOAD_MAX) + 2];
+    size_t length = 0;
+
+    payload[length++] = RECORD_TOKEN;
+    payload[length++] = (uint8_t)token;
+    payload[length++] = (uint8_t)(token >> 8);
+
+    if (count > NPZ_TOKEN_MAX_ARGS)
+    {
+        count = NPZ_TOKEN_MAX_ARGS;
+    }
+
+    // Seven bits per byte, lowest first, so small values take a single byte
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t value = args[i];
+
+        while (value >= 0x80)
+        {
+            payload[length++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+
+        payload[length++] = (uint8_t)value;
+    }
+
+    // Delimited on both sides, so text printed just before is not taken as part of the frame
+    frame[0] = NPZ_COBS_DELIMITER;
+    length = npz_cobs_encode(payload, length, &frame[1]) + 1;
+    frame[length++] = NPZ_COBS_DELIMITER;
+    fwrite(frame, 1, length, stdout);
+}
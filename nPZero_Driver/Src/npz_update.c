@@ -0,0 +1,583 @@
+/**
+ * @file npz_update.c
+ * @brief Implementation of the streaming configuration update.
+ *
+ * Payload bytes are held back by two, since only the end of the frame tells the CRC apart from record bytes. Records
+ * are written to flash in whole words as they complete, and the page header that makes them valid only once the CRC
+ * has matched. The header carries a sequence number, the valid page with the newer one is the stored configuration.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include "../../nPZero_xc32.X/main.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define PAGE_MAGIC   0x4E55 /**< "NU", a committed page. */
+#define RX_SIZE      64     /**< Bytes buffered between the receive interrupt and npz_update_run(). */
+#define RX_MASK      (RX_SIZE - 1)
+
+/*****************************************************************************
+ * Types
+ *****************************************************************************/
+
+/** Layout of a flash page. The first two words are left erased until the records are complete. */
+typedef struct
+{
+    uint16_t magic;    /**< PAGE_MAGIC once committed. */
+    uint16_t length;   /**< Bytes of records. */
+    uint16_t sequence; /**< Incremented with every committed update. */
+    uint16_t crc;      /**< CRC of the records. */
+    uint8_t records[NPZ_UPDATE_STORE_SIZE];
+} page_s;
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+/** Pages of program flash of their own, erased when the firmware is flashed. */
+static const page_s m_pages[2] __attribute__((aligned(NPZ_HAL_FLASH_PAGE_SIZE))) = {
+    {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, {[0 ... NPZ_UPDATE_STORE_SIZE - 1] = 0xFF}},
+    {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, {[0 ... NPZ_UPDATE_STORE_SIZE - 1] = 0xFF}},
+};
+
+static uint8_t m_rx[RX_SIZE];
+static volatile uint16_t m_rx_head; /**< Written by the receive interrupt only. */
+static volatile uint16_t m_rx_tail;
+static volatile uint32_t m_last_rx; /**< npz_hal_get_ms() at the last byte received. */
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Page as the flash holds it now, read uncached and never from what the compiler knows of the initializer.
+ */
+static const volatile page_s *page(uint8_t index)
+{
+    return (const volatile page_s *) KVA0_TO_KVA1((uintptr_t) &m_pages[index]);
+}
+
+static bool is_committed(uint8_t index)
+{
+    const volatile page_s *p = page(index);
+    uint16_t crc = NPZ_CRC16_INIT;
+
+    if (p->magic != PAGE_MAGIC || p->length > NPZ_UPDATE_STORE_SIZE)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < p->length; i++)
+    {
+        uint8_t value = p->records[i];
+
+        crc = npz_crc16(crc, &value, 1);
+    }
+
+    return crc == p->crc;
+}
+
+/**
+ * @brief Index of the page holding the stored records, -1 if there is none.
+ */
+static int stored_page(void)
+{
+    bool valid[2] = {is_committed(0), is_committed(1)};
+
+    if (valid[0] && valid[1])
+    {
+        // After a reset between the commit and the erase of the old page, the newer sequence wins
+        return ((int16_t)(page(1)->sequence - page(0)->sequence) > 0) ? 1 : 0;
+    }
+
+    return valid[0] ? 0 : (valid[1] ? 1 : -1);
+}
+
+static npz_status_e erase_if_used(uint8_t index)
+{
+    const volatile uint32_t *words = (const volatile uint32_t *) page(index);
+
+    for (uint16_t i = 0; i < NPZ_HAL_FLASH_PAGE_SIZE / 4; i++)
+    {
+        if (words[i] != 0xFFFFFFFFU)
+        {
+            return npz_hal_flash_erase(&m_pages[index]);
+        }
+    }
+
+    return OK;
+}
+
+/**
+ * @brief Appends bytes to the records of the page being written, a flash word at a time.
+ */
+static npz_update_result_e store(npz_update_s *update, const uint8_t *data, uint16_t size)
+{
+    if (update->stored + size > NPZ_UPDATE_STORE_SIZE)
+    {
+        return NPZ_UPDATE_ERR_SPACE;
+    }
+
+    for (uint16_t i = 0; i < size; i++)
+    {
+        update->word[update->stored % 4] = data[i];
+        update->stored++;
+
+        if (update->stored % 4 == 0)
+        {
+            uint32_t word;
+
+            memcpy(&word, update->word, 4);
+
+            if (npz_hal_flash_write_word(&m_pages[update->page].records[update->stored - 4], word) != OK)
+            {
+                return NPZ_UPDATE_ERR_FLASH;
+            }
+        }
+    }
+
+    return NPZ_UPDATE_OK;
+}
+
+/**
+ * @brief Starts the new page with the stored records, so a DELTA update adds to them.
+ */
+static npz_update_result_e copy_stored(npz_update_s *update)
+{
+    int from = stored_page();
+    uint16_t length;
+
+    if (from < 0)
+    {
+        return NPZ_UPDATE_OK;
+    }
+
+    length = page(from)->length;
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        uint8_t value = page(from)->records[i];
+        npz_update_result_e result = store(update, &value, 1);
+
+        if (result != NPZ_UPDATE_OK)
+        {
+            return result;
+        }
+    }
+
+    return NPZ_UPDATE_OK;
+}
+
+/**
+ * @brief Writes the header that makes the new page the stored configuration, the magic last.
+ */
+static npz_update_result_e commit(npz_update_s *update)
+{
+    const volatile page_s *p = page(update->page);
+    int previous = stored_page();
+    uint16_t length = update->stored;
+    uint16_t sequence = (previous < 0) ? 0 : (uint16_t)(page(previous)->sequence + 1);
+    uint16_t crc = NPZ_CRC16_INIT;
+    uint8_t padding = 0xFF;
+
+    // NPZ_UPDATE_STORE_SIZE is a multiple of 4, so the padding always fits
+    while (update->stored % 4 != 0)
+    {
+        if (store(update, &padding, 1) != NPZ_UPDATE_OK)
+        {
+            return NPZ_UPDATE_ERR_FLASH;
+        }
+    }
+
+    // Computed from the flash rather than the frame, which also checks the programming
+    for (uint16_t i = 0; i < length; i++)
+    {
+        uint8_t value = p->records[i];
+
+        crc = npz_crc16(crc, &value, 1);
+    }
+
+    if (npz_hal_flash_write_word(&m_pages[update->page].sequence, sequence | ((uint32_t) crc << 16)) != OK ||
+        npz_hal_flash_write_word(&m_pages[update->page].magic, PAGE_MAGIC | ((uint32_t) length << 16)) != OK)
+    {
+        return NPZ_UPDATE_ERR_FLASH;
+    }
+
+    return is_committed(update->page) ? NPZ_UPDATE_OK : NPZ_UPDATE_ERR_FLASH;
+}
+
+/**
+ * @brief Handles the kind byte at the start of a frame.
+ */
+static npz_update_result_e start(npz_update_s *update, uint8_t kind)
+{
+    update->stored = 0;
+
+    if (kind == NPZ_UPDATE_DELTA)
+    {
+        return copy_stored(update);
+    }
+
+    if (kind != NPZ_UPDATE_FULL)
+    {
+        return NPZ_UPDATE_ERR_FORMAT;
+    }
+
+    // The stored records are dropped, so their registers go back to the base configuration
+    update->touched = true;
+
+    return (npz_device_configure(update->config) == OK) ? NPZ_UPDATE_OK : NPZ_UPDATE_ERR_BUS;
+}
+
+static bool is_allowed(const npz_update_s *update, uint8_t reg, uint8_t count)
+{
+    for (uint16_t address = reg; address < reg + count; address++)
+    {
+        if (address > REG_SRAM_END || !(update->allowed[address / 8] & (1U << (address % 8))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Handles a record byte, writing the record to the device and to flash once it is complete.
+ */
+static npz_update_result_e record_byte(npz_update_s *update, uint8_t byte)
+{
+    uint8_t header[2];
+    npz_update_result_e result;
+
+    if (update->header == 0)
+    {
+        update->reg = byte;
+        update->header = 1;
+        return NPZ_UPDATE_OK;
+    }
+
+    if (update->header == 1)
+    {
+        update->count = byte;
+        update->filled = 0;
+        update->header = 2;
+
+        if (byte == 0 || byte > NPZ_UPDATE_RECORD_MAX)
+        {
+            return NPZ_UPDATE_ERR_FORMAT;
+        }
+
+        return is_allowed(update, update->reg, update->count) ? NPZ_UPDATE_OK : NPZ_UPDATE_ERR_REGISTER;
+    }
+
+    update->values[update->filled++] = byte;
+
+    if (update->filled < update->count)
+    {
+        return NPZ_UPDATE_OK;
+    }
+
+    update->header = 0;
+    update->touched = true;
+
+    if (npz_write_register(update->reg, update->values, update->count) != OK)
+    {
+        return NPZ_UPDATE_ERR_BUS;
+    }
+
+    header[0] = update->reg;
+    header[1] = update->count;
+    result = store(update, header, sizeof(header));
+
+    return (result == NPZ_UPDATE_OK) ? store(update, update->values, update->count) : result;
+}
+
+/**
+ * @brief Handles a payload byte once it is known not to be part of the CRC.
+ */
+static void process(npz_update_s *update, uint8_t byte, bool first)
+{
+    update->crc = npz_crc16(update->crc, &byte, 1);
+
+    if (update->result != NPZ_UPDATE_OK)
+    {
+        return;
+    }
+
+    update->result = first ? start(update, byte) : record_byte(update, byte);
+}
+
+/**
+ * @brief Checks a complete frame, then keeps or undoes it.
+ */
+static npz_update_result_e end_frame(npz_update_s *update)
+{
+    npz_update_result_e result = update->result;
+    uint8_t spare = update->page ^ 1;
+
+    if (result == NPZ_UPDATE_OK && (update->received < 3 || update->header != 0))
+    {
+        result = NPZ_UPDATE_ERR_FORMAT;
+    }
+
+    if (result == NPZ_UPDATE_OK && (update->tail[0] | (update->tail[1] << 8)) != update->crc)
+    {
+        result = NPZ_UPDATE_ERR_CRC;
+    }
+
+    if (result == NPZ_UPDATE_OK)
+    {
+        result = commit(update);
+    }
+
+    if (result == NPZ_UPDATE_OK)
+    {
+        // The old page becomes the spare. Should the erase fail, npz_update_begin() tries again next time.
+        erase_if_used(spare);
+        update->page = spare;
+    }
+    else
+    {
+        erase_if_used(update->page);
+
+        if (update->touched)
+        {
+            npz_update_configure(update->config);
+        }
+    }
+
+    memset(&update->decoder, 0, sizeof(update->decoder));
+    update->received = 0;
+    update->crc = NPZ_CRC16_INIT;
+    update->result = NPZ_UPDATE_OK;
+    update->touched = false;
+    update->header = 0;
+    update->stored = 0;
+
+    return result;
+}
+
+/**
+ * @brief Receive callback of the HAL, called from the receive and error interrupts.
+ */
+static void on_receive(uint8_t byte, bool ok)
+{
+    m_last_rx = npz_hal_get_ms();
+
+    // A byte dropped here fails the CRC of its frame
+    if (ok && (uint16_t)(m_rx_head - m_rx_tail) < RX_SIZE)
+    {
+        m_rx[m_rx_head & RX_MASK] = byte;
+        m_rx_head++;
+    }
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_status_e npz_update_begin(npz_update_s *update, const npz_device_config_s *device_config,
+                              const npz_image_s *base)
+{
+    int stored = stored_page();
+
+    if (update == NULL || device_config == NULL || base == NULL || base->overflow)
+    {
+        return INVALID_PARAM;
+    }
+
+    memset(update, 0, sizeof(*update));
+    update->config = device_config;
+    update->crc = NPZ_CRC16_INIT;
+    update->page = (stored == 0) ? 1 : 0;
+
+    for (uint16_t i = 0; i < base->count; i++)
+    {
+        update->allowed[base->reg[i] / 8] |= (uint8_t)(1U << (base->reg[i] % 8));
+    }
+
+    // A configuration that soft resets the device first must still not let a record put it to sleep
+    update->allowed[REG_SLEEP_RST / 8] &= (uint8_t) ~(1U << (REG_SLEEP_RST % 8));
+
+    return erase_if_used(update->page);
+}
+
+bool npz_update_feed(npz_update_s *update, uint8_t byte, npz_update_result_e *result)
+{
+    uint8_t value;
+
+    switch (npz_cobs_decode_byte(&update->decoder, byte, &value))
+    {
+    case NPZ_COBS_BYTE:
+        if (update->received >= 2)
+        {
+            process(update, update->tail[0], update->received == 2);
+        }
+
+        update->tail[0] = update->tail[1];
+        update->tail[1] = value;
+
+        if (update->received < UINT16_MAX)
+        {
+            update->received++;
+        }
+
+        return false;
+
+    case NPZ_COBS_END:
+        // Delimiters between frames
+        if (update->received == 0)
+        {
+            return false;
+        }
+
+        *result = end_frame(update);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+npz_status_e npz_update_run(const npz_device_config_s *device_config, const npz_image_s *base, uint32_t idle_timeout,
+                            bool *changed)
+{
+    static npz_update_s update;
+    npz_update_result_e result;
+    npz_status_e status;
+    char text[16];
+
+    if (changed != NULL)
+    {
+        *changed = false;
+    }
+
+    if (!npz_hal_uart_is_on())
+    {
+        return INVALID_PARAM;
+    }
+
+    // Erases the spare page before the host starts sending, the receive interrupt cannot run meanwhile
+    status = npz_update_begin(&update, device_config, base);
+
+    if (status != OK)
+    {
+        return status;
+    }
+
+    m_rx_head = 0;
+    m_rx_tail = 0;
+    m_last_rx = npz_hal_get_ms();
+
+    // The spare page is only erased, nothing is lost if the receiver is taken
+    if (!npz_hal_uart_receive_start(on_receive))
+    {
+        return INVALID_PARAM;
+    }
+
+    while ((npz_hal_get_ms() - m_last_rx) < idle_timeout)
+    {
+        if (m_rx_tail == m_rx_head)
+        {
+            continue;
+        }
+
+        if (!npz_update_feed(&update, m_rx[m_rx_tail & RX_MASK], &result))
+        {
+            m_rx_tail++;
+            continue;
+        }
+
+        m_rx_tail++;
+
+        if (result == NPZ_UPDATE_OK)
+        {
+            snprintf(text, sizeof(text), "OK\r\n");
+
+            if (changed != NULL)
+            {
+                *changed = true;
+            }
+        }
+        else
+        {
+            snprintf(text, sizeof(text), "ERR %d\r\n", result);
+        }
+
+        npz_console_write(text, strlen(text));
+
+        // The host waits for the answer, the flash and bus work before it is no idle time
+        m_last_rx = npz_hal_get_ms();
+    }
+
+    npz_hal_uart_receive_stop();
+    npz_console_drain(NPZ_SLEEP_DRAIN_TIMEOUT_MS);
+
+    return OK;
+}
+
+npz_status_e npz_update_configure(const npz_device_config_s *device_config)
+{
+    npz_status_e status = npz_device_configure(device_config);
+    uint8_t values[NPZ_UPDATE_RECORD_MAX];
+    int stored = stored_page();
+    uint16_t length;
+
+    if (status != OK || stored < 0)
+    {
+        return status;
+    }
+
+    length = page(stored)->length;
+
+    for (uint16_t i = 0; i + 2 <= length;)
+    {
+        uint8_t reg = page(stored)->records[i];
+        uint8_t count = page(stored)->records[i + 1];
+
+        // Checked when received, a record that does not fit now means the flash is corrupt
+        if (count == 0 || count > NPZ_UPDATE_RECORD_MAX || i + 2 + count > length)
+        {
+            return ERR;
+        }
+
+        for (uint8_t j = 0; j < count; j++)
+        {
+            values[j] = page(stored)->records[i + 2 + j];
+        }
+
+        if (npz_write_register(reg, values, count) != OK)
+        {
+            return ERR;
+        }
+
+        i += 2 + count;
+    }
+
+    return OK;
+}
+
+uint16_t npz_update_signature(uint16_t crc)
+{
+    int stored = stored_page();
+
+    if (stored < 0)
+    {
+        return crc;
+    }
+
+    for (uint16_t i = 0; i < page(stored)->length; i++)
+    {
+        uint8_t value = page(stored)->records[i];
+
+        crc = npz_crc16(crc, &value, 1);
+    }
+
+    return crc;
+}
@@ -26,15 +26,37 @@
 #include <stdint.h>
 #include <string.h>
 
+/* Driver settings of this application, ahead of the defaults of npz_config.h so every file sees the same value */
+
+/* app_retained_s of main.c, 88 bytes, behind its header at the end of the device SRAM. 32 bytes are left to init
+   sequences */
+#define NPZ_RETAINED_SIZE 96
+
+#include "../nPZero_Driver/Inc/npz_config.h"
+#include "../nPZero_Driver/Inc/npz_cobs.h"
+#include "../nPZero_Driver/Inc/npz_console.h"
+#include "../nPZero_Driver/Inc/npz_convert.h"
+#include "../nPZero_Driver/Inc/npz_crc.h"
 #include "../nPZero_Driver/Inc/npz.h"
 #include "../nPZero_Driver/Inc/npz_device_control.h"
+#include "../nPZero_Driver/Inc/npz_event.h"
+#include "../nPZero_Driver/Inc/npz_fleet.h"
 #include "../nPZero_Driver/Inc/npz_hal.h"
+#include "../nPZero_Driver/Inc/npz_history.h"
 #include "../nPZero_Driver/Inc/npz_logs.h"
 #include "../nPZero_Driver/Inc/npz_registers.h"
-
-#define _XTAL_FREQ 8000000UL // Example: For a 16MHz clock
-
-#define TICK_PER_MS (_XTAL_FREQ/2/1000)
+#include "../nPZero_Driver/Inc/npz_retained.h"
+#include "../nPZero_Driver/Inc/npz_sensor_codec.h"
+#include "../nPZero_Driver/Inc/npz_shell.h"
+#include "../nPZero_Driver/Inc/npz_stats.h"
+#include "../nPZero_Driver/Inc/npz_time.h"
+#include "../nPZero_Driver/Inc/npz_token.h"
+#include "../nPZero_Driver/Inc/npz_update.h"
+#include "../nPZero_Driver/Inc/npz_batch.h"
+#include "../nPZero_Driver/Inc/npz_report.h"
+
+/* The core timer counts at half the system clock, CPU_CLOCK_FREQUENCY of the Harmony configuration */
+#define TICK_PER_MS (CPU_CLOCK_FREQUENCY / 2 / 1000)
 
 
 /* ************************************************************************** */
@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../nPZero_Driver/Src/npz.c ../nPZero_Driver/Src/npz_device_control.c ../nPZero_Driver/Src/npz_hal.c ../nPZero_Driver/Src/npz_logs.c ../src/main.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../nPZero_Driver/Src/npz.c ../nPZero_Driver/Src/npz_device_control.c ../nPZero_Driver/Src/npz_hal.c ../nPZero_Driver/Src/npz_logs.c ../nPZero_Driver/Src/npz_event.c ../nPZero_Driver/Src/npz_fleet.c ../nPZero_Driver/Src/npz_convert.c ../nPZero_Driver/Src/npz_sensor_codec.c ../nPZero_Driver/Src/npz_history.c ../nPZero_Driver/Src/npz_crc.c ../nPZero_Driver/Src/npz_retained.c ../nPZero_Driver/Src/npz_time.c ../nPZero_Driver/Src/npz_batch.c ../nPZero_Driver/Src/npz_stats.c ../nPZero_Driver/Src/npz_console.c ../nPZero_Driver/Src/npz_cobs.c ../nPZero_Driver/Src/npz_token.c ../nPZero_Driver/Src/npz_shell.c ../nPZero_Driver/Src/npz_update.c ../nPZero_Driver/Src/npz_report.c ../src/main.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/333714205/npz.o ${OBJECTDIR}/_ext/333714205/npz_device_control.o ${OBJECTDIR}/_ext/333714205/npz_hal.o ${OBJECTDIR}/_ext/333714205/npz_logs.o ${OBJECTDIR}/_ext/1360937237/main.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o.d ${OBJECTDIR}/_ext/1865200349/plib_evic.o.d ${OBJECTDIR}/_ext/1865254177/plib_gpio.o.d ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o.d ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o.d ${OBJECTDIR}/_ext/1865657120/plib_uart1.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/333714205/npz.o.d ${OBJECTDIR}/_ext/333714205/npz_device_control.o.d ${OBJECTDIR}/_ext/333714205/npz_hal.o.d ${OBJECTDIR}/_ext/333714205/npz_logs.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/333714205/npz.o ${OBJECTDIR}/_ext/333714205/npz_device_control.o ${OBJECTDIR}/_ext/333714205/npz_hal.o ${OBJECTDIR}/_ext/333714205/npz_logs.o ${OBJECTDIR}/_ext/333714205/npz_event.o ${OBJECTDIR}/_ext/333714205/npz_fleet.o ${OBJECTDIR}/_ext/333714205/npz_convert.o ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o ${OBJECTDIR}/_ext/333714205/npz_history.o ${OBJECTDIR}/_ext/333714205/npz_crc.o ${OBJECTDIR}/_ext/333714205/npz_retained.o ${OBJECTDIR}/_ext/333714205/npz_time.o ${OBJECTDIR}/_ext/333714205/npz_batch.o ${OBJECTDIR}/_ext/333714205/npz_stats.o ${OBJECTDIR}/_ext/333714205/npz_console.o ${OBJECTDIR}/_ext/333714205/npz_cobs.o ${OBJECTDIR}/_ext/333714205/npz_token.o ${OBJECTDIR}/_ext/333714205/npz_shell.o ${OBJECTDIR}/_ext/333714205/npz_update.o ${OBJECTDIR}/_ext/333714205/npz_report.o ${OBJECTDIR}/_ext/1360937237/main.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o.d ${OBJECTDIR}/_ext/1865200349/plib_evic.o.d ${OBJECTDIR}/_ext/1865254177/plib_gpio.o.d ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o.d ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o.d ${OBJECTDIR}/_ext/1865657120/plib_uart1.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/333714205/npz.o.d ${OBJECTDIR}/_ext/333714205/npz_device_control.o.d ${OBJECTDIR}/_ext/333714205/npz_hal.o.d ${OBJECTDIR}/_ext/333714205/npz_logs.o.d ${OBJECTDIR}/_ext/333714205/npz_event.o.d ${OBJECTDIR}/_ext/333714205/npz_fleet.o.d ${OBJECTDIR}/_ext/333714205/npz_convert.o.d ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o.d ${OBJECTDIR}/_ext/333714205/npz_history.o.d ${OBJECTDIR}/_ext/333714205/npz_crc.o.d ${OBJECTDIR}/_ext/333714205/npz_retained.o.d ${OBJECTDIR}/_ext/333714205/npz_time.o.d ${OBJECTDIR}/_ext/333714205/npz_batch.o.d ${OBJECTDIR}/_ext/333714205/npz_stats.o.d ${OBJECTDIR}/_ext/333714205/npz_console.o.d ${OBJECTDIR}/_ext/333714205/npz_cobs.o.d ${OBJECTDIR}/_ext/333714205/npz_token.o.d ${OBJECTDIR}/_ext/333714205/npz_shell.o.d ${OBJECTDIR}/_ext/333714205/npz_update.o.d ${OBJECTDIR}/_ext/333714205/npz_report.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/333714205/npz.o ${OBJECTDIR}/_ext/333714205/npz_device_control.o ${OBJECTDIR}/_ext/333714205/npz_hal.o ${OBJECTDIR}/_ext/333714205/npz_logs.o ${OBJECTDIR}/_ext/1360937237/main.o
+OBJECTFILES=${OBJECTDIR}/_ext/60165520/plib_clk.o ${OBJECTDIR}/_ext/1865200349/plib_evic.o ${OBJECTDIR}/_ext/1865254177/plib_gpio.o ${OBJECTDIR}/_ext/513455433/plib_i2c1_master.o ${OBJECTDIR}/_ext/60169480/plib_i2c_smbus_common.o ${OBJECTDIR}/_ext/1865657120/plib_uart1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/333714205/npz.o ${OBJECTDIR}/_ext/333714205/npz_device_control.o ${OBJECTDIR}/_ext/333714205/npz_hal.o ${OBJECTDIR}/_ext/333714205/npz_logs.o ${OBJECTDIR}/_ext/333714205/npz_event.o ${OBJECTDIR}/_ext/333714205/npz_fleet.o ${OBJECTDIR}/_ext/333714205/npz_convert.o ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o ${OBJECTDIR}/_ext/333714205/npz_history.o ${OBJECTDIR}/_ext/333714205/npz_crc.o ${OBJECTDIR}/_ext/333714205/npz_retained.o ${OBJECTDIR}/_ext/333714205/npz_time.o ${OBJECTDIR}/_ext/333714205/npz_batch.o ${OBJECTDIR}/_ext/333714205/npz_stats.o ${OBJECTDIR}/_ext/333714205/npz_console.o ${OBJECTDIR}/_ext/333714205/npz_cobs.o ${OBJECTDIR}/_ext/333714205/npz_token.o ${OBJECTDIR}/_ext/333714205/npz_shell.o ${OBJECTDIR}/_ext/333714205/npz_update.o ${OBJECTDIR}/_ext/333714205/npz_report.o ${OBJECTDIR}/_ext/1360937237/main.o
 
 # Source Files
-SOURCEFILES=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../nPZero_Driver/Src/npz.c ../nPZero_Driver/Src/npz_device_control.c ../nPZero_Driver/Src/npz_hal.c ../nPZero_Driver/Src/npz_logs.c ../src/main.c
+SOURCEFILES=../src/config/default/peripheral/clk/plib_clk.c ../src/config/default/peripheral/evic/plib_evic.c ../src/config/default/peripheral/gpio/plib_gpio.c ../src/config/default/peripheral/i2c/master/plib_i2c1_master.c ../src/config/default/peripheral/i2c/plib_i2c_smbus_common.c ../src/config/default/peripheral/uart/plib_uart1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../nPZero_Driver/Src/npz.c ../nPZero_Driver/Src/npz_device_control.c ../nPZero_Driver/Src/npz_hal.c ../nPZero_Driver/Src/npz_logs.c ../nPZero_Driver/Src/npz_event.c ../nPZero_Driver/Src/npz_fleet.c ../nPZero_Driver/Src/npz_convert.c ../nPZero_Driver/Src/npz_sensor_codec.c ../nPZero_Driver/Src/npz_history.c ../nPZero_Driver/Src/npz_crc.c ../nPZero_Driver/Src/npz_retained.c ../nPZero_Driver/Src/npz_time.c ../nPZero_Driver/Src/npz_batch.c ../nPZero_Driver/Src/npz_stats.c ../nPZero_Driver/Src/npz_console.c ../nPZero_Driver/Src/npz_cobs.c ../nPZero_Driver/Src/npz_token.c ../nPZero_Driver/Src/npz_shell.c ../nPZero_Driver/Src/npz_update.c ../nPZero_Driver/Src/npz_report.c ../src/main.c
 
 
 
@@ -185,6 +185,102 @@ ${OBJECTDIR}/_ext/333714205/npz_logs.o: ../nPZero_Driver/Src/npz_logs.c  .genera
 	@${RM} ${OBJECTDIR}/_ext/333714205/npz_logs.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_logs.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_logs.o ../nPZero_Driver/Src/npz_logs.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
 	
+${OBJECTDIR}/_ext/333714205/npz_event.o: ../nPZero_Driver/Src/npz_event.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_event.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_event.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_event.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_event.o ../nPZero_Driver/Src/npz_event.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_fleet.o: ../nPZero_Driver/Src/npz_fleet.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_fleet.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_fleet.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_fleet.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_fleet.o ../nPZero_Driver/Src/npz_fleet.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_convert.o: ../nPZero_Driver/Src/npz_convert.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_convert.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_convert.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_convert.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_convert.o ../nPZero_Driver/Src/npz_convert.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o: ../nPZero_Driver/Src/npz_sensor_codec.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o ../nPZero_Driver/Src/npz_sensor_codec.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_history.o: ../nPZero_Driver/Src/npz_history.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_history.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_history.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_history.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_history.o ../nPZero_Driver/Src/npz_history.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_crc.o: ../nPZero_Driver/Src/npz_crc.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_crc.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_crc.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_crc.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_crc.o ../nPZero_Driver/Src/npz_crc.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_retained.o: ../nPZero_Driver/Src/npz_retained.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_retained.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_retained.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_retained.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_retained.o ../nPZero_Driver/Src/npz_retained.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_time.o: ../nPZero_Driver/Src/npz_time.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_time.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_time.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_time.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_time.o ../nPZero_Driver/Src/npz_time.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_batch.o: ../nPZero_Driver/Src/npz_batch.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_batch.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_batch.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_batch.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_batch.o ../nPZero_Driver/Src/npz_batch.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_stats.o: ../nPZero_Driver/Src/npz_stats.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_stats.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_stats.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_stats.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_stats.o ../nPZero_Driver/Src/npz_stats.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_console.o: ../nPZero_Driver/Src/npz_console.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_console.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_console.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_console.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_console.o ../nPZero_Driver/Src/npz_console.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_cobs.o: ../nPZero_Driver/Src/npz_cobs.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_cobs.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_cobs.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_cobs.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_cobs.o ../nPZero_Driver/Src/npz_cobs.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_token.o: ../nPZero_Driver/Src/npz_token.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_token.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_token.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_token.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_token.o ../nPZero_Driver/Src/npz_token.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_shell.o: ../nPZero_Driver/Src/npz_shell.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_shell.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_shell.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_shell.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_shell.o ../nPZero_Driver/Src/npz_shell.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_update.o: ../nPZero_Driver/Src/npz_update.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_update.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_update.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_update.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_update.o ../nPZero_Driver/Src/npz_update.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_report.o: ../nPZero_Driver/Src/npz_report.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_report.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_report.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD4=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_report.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_report.o ../nPZero_Driver/Src/npz_report.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
 ${OBJECTDIR}/_ext/1360937237/main.o: ../src/main.c  .generated_files/flags/default/7c7c82fc7756298bef14b9f0479861e14944818c .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/main.o.d 
@@ -276,6 +372,102 @@ ${OBJECTDIR}/_ext/333714205/npz_logs.o: ../nPZero_Driver/Src/npz_logs.c  .genera
 	@${RM} ${OBJECTDIR}/_ext/333714205/npz_logs.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_logs.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_logs.o ../nPZero_Driver/Src/npz_logs.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
 	
+${OBJECTDIR}/_ext/333714205/npz_event.o: ../nPZero_Driver/Src/npz_event.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_event.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_event.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_event.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_event.o ../nPZero_Driver/Src/npz_event.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_fleet.o: ../nPZero_Driver/Src/npz_fleet.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_fleet.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_fleet.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_fleet.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_fleet.o ../nPZero_Driver/Src/npz_fleet.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_convert.o: ../nPZero_Driver/Src/npz_convert.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_convert.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_convert.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_convert.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_convert.o ../nPZero_Driver/Src/npz_convert.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o: ../nPZero_Driver/Src/npz_sensor_codec.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_sensor_codec.o ../nPZero_Driver/Src/npz_sensor_codec.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_history.o: ../nPZero_Driver/Src/npz_history.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_history.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_history.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_history.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_history.o ../nPZero_Driver/Src/npz_history.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_crc.o: ../nPZero_Driver/Src/npz_crc.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_crc.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_crc.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_crc.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_crc.o ../nPZero_Driver/Src/npz_crc.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_retained.o: ../nPZero_Driver/Src/npz_retained.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_retained.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_retained.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_retained.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_retained.o ../nPZero_Driver/Src/npz_retained.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_time.o: ../nPZero_Driver/Src/npz_time.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_time.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_time.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_time.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_time.o ../nPZero_Driver/Src/npz_time.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_batch.o: ../nPZero_Driver/Src/npz_batch.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_batch.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_batch.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_batch.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_batch.o ../nPZero_Driver/Src/npz_batch.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_stats.o: ../nPZero_Driver/Src/npz_stats.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_stats.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_stats.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_stats.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_stats.o ../nPZero_Driver/Src/npz_stats.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_console.o: ../nPZero_Driver/Src/npz_console.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_console.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_console.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_console.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_console.o ../nPZero_Driver/Src/npz_console.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_cobs.o: ../nPZero_Driver/Src/npz_cobs.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_cobs.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_cobs.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_cobs.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_cobs.o ../nPZero_Driver/Src/npz_cobs.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_token.o: ../nPZero_Driver/Src/npz_token.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_token.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_token.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_token.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_token.o ../nPZero_Driver/Src/npz_token.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_shell.o: ../nPZero_Driver/Src/npz_shell.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_shell.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_shell.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_shell.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_shell.o ../nPZero_Driver/Src/npz_shell.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_update.o: ../nPZero_Driver/Src/npz_update.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_update.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_update.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_update.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_update.o ../nPZero_Driver/Src/npz_update.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
+${OBJECTDIR}/_ext/333714205/npz_report.o: ../nPZero_Driver/Src/npz_report.c  .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/333714205" 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_report.o.d 
+	@${RM} ${OBJECTDIR}/_ext/333714205/npz_report.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -MP -MMD -MF "${OBJECTDIR}/_ext/333714205/npz_report.o.d" -o ${OBJECTDIR}/_ext/333714205/npz_report.o ../nPZero_Driver/Src/npz_report.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}"  
+	
 ${OBJECTDIR}/_ext/1360937237/main.o: ../src/main.c  .generated_files/flags/default/94e59af40906c43a062db687ef10e60f20c89fca .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/main.o.d 
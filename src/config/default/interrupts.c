@@ -68,6 +68,7 @@
 // *****************************************************************************
 void UART_1_Handler (void);
 void I2C_1_Handler (void);
+void DMA_0_Handler (void);
 
 
 // *****************************************************************************
@@ -85,6 +86,11 @@ void __attribute__((used)) __ISR(_I2C_1_VECTOR, ipl1SOFT) I2C_1_Handler (void)
     I2C_1_InterruptHandler();
 }
 
+void __attribute__((used)) __ISR(_DMA_0_VECTOR, ipl1SOFT) DMA_0_Handler (void)
+{
+    DMA0_InterruptHandler();
+}
+
 
 
 
@@ -57,6 +57,7 @@
 // *****************************************************************************
 // *****************************************************************************
 void UART_1_InterruptHandler( void );
+void DMA0_InterruptHandler( void );
 void I2C_1_InterruptHandler( void );
 
 
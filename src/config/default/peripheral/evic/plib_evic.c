@@ -58,6 +58,7 @@ void EVIC_Initialize( void )
     /* Set up priority and subpriority of enabled interrupts */
     IPC8SET = 0x4U | 0x0U;  /* UART_1:  Priority 1 / Subpriority 0 */
     IPC8SET = 0x400U | 0x0U;  /* I2C_1:  Priority 1 / Subpriority 0 */
+    IPC9SET = 0x4U | 0x0U;  /* DMA_0:  Priority 1 / Subpriority 0 */
 
 
 }
@@ -38,6 +38,7 @@
 * THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
 *******************************************************************************/
 
+#include <sys/kmem.h>
 #include "device.h"
 #include "plib_uart1.h"
 #include "interrupts.h"
@@ -50,6 +51,12 @@
 
 static volatile UART_OBJECT uart1Obj;
 
+/* DMA transmit path, see UART1_DMAWrite(). Channel 0 is reserved for it. */
+static volatile bool uart1DMABusy = false;
+static volatile bool uart1DMAError = false;
+static UART_CALLBACK uart1DMACallback = NULL;
+static uintptr_t uart1DMAContext = 0;
+
 static void UART1_ErrorClear( void )
 {
     UART_ERROR errors = UART_ERROR_NONE;
@@ -118,10 +125,45 @@ void UART1_Initialize( void )
     uart1Obj.txCallback = NULL;
     uart1Obj.errors = UART_ERROR_NONE;
 
+    /* DMA channel 0 moves bytes to U1TXREG, one per UART1 TX interrupt request */
+    DCH0CONCLR = _DCH0CON_CHEN_MASK;
+    DMACONSET = _DMACON_ON_MASK;
+    DCH0ECON = ((uint32_t)_UART1_TX_IRQ << _DCH0ECON_CHSIRQ_POSITION) | _DCH0ECON_SIRQEN_MASK;
+    DCH0INT = _DCH0INT_CHBCIE_MASK | _DCH0INT_CHERIE_MASK;
+    IFS1CLR = _IFS1_DMA0IF_MASK;
+    IEC1SET = _IEC1_DMA0IE_MASK;
+    uart1DMABusy = false;
+
     /* Turn ON UART1 */
     U1MODESET = _U1MODE_ON_MASK;
 }
 
+void UART1_Disable( void )
+{
+    /* Stop a DMA write first, the channel must not feed a disabled UART */
+    DCH0CONCLR = _DCH0CON_CHEN_MASK;
+
+    while((DCH0CON & _DCH0CON_CHBUSY_MASK) != 0U)
+    {
+    }
+
+    IEC1CLR = _IEC1_DMA0IE_MASK;
+    DCH0INTCLR = _DCH0INT_CHBCIF_MASK | _DCH0INT_CHERIF_MASK;
+    IFS1CLR = _IFS1_DMA0IF_MASK;
+
+    /* Then the interrupts of the UART, so none of them fires against the disabled module */
+    IEC1CLR = _IEC1_U1TXIE_MASK | _IEC1_U1RXIE_MASK | _IEC1_U1EIE_MASK;
+    IFS1CLR = _IFS1_U1TXIF_MASK | _IFS1_U1RXIF_MASK | _IFS1_U1EIF_MASK;
+
+    /* Transfers in progress are dropped without their callbacks */
+    uart1DMABusy = false;
+    uart1Obj.txBusyStatus = false;
+    uart1Obj.rxBusyStatus = false;
+
+    /* Turn OFF UART1 */
+    U1MODECLR = _U1MODE_ON_MASK;
+}
+
 bool UART1_SerialSetup( UART_SERIAL_SETUP *setup, uint32_t srcClkFreq )
 {
     bool status = false;
@@ -299,6 +341,51 @@ bool UART1_Write( void* buffer, const size_t size )
     return status;
 }
 
+bool UART1_DMAWrite( void *buffer, const size_t size )
+{
+    bool status = false;
+
+    /* DCH0SSIZ holds 16 bits, 9-bit mode is not supported */
+    if((buffer != NULL) && (size != 0U) && (size <= 65535U) && (uart1Obj.txBusyStatus == false))
+    {
+        uart1Obj.txBuffer = buffer;
+        uart1Obj.txSize = size;
+        uart1Obj.txProcessedSize = 0;
+        uart1Obj.txBusyStatus = true;
+        uart1DMABusy = true;
+        uart1DMAError = false;
+        status = true;
+
+        /* The TX interrupt is left to the DMA until the last byte is in the transmit buffer */
+        IEC1CLR = _IEC1_U1TXIE_MASK;
+
+        /* Request a byte while the transmit buffer has at least one empty space */
+        U1STACLR = _U1STA_UTXISEL_MASK;
+
+        DCH0SSA = KVA_TO_PA(buffer);
+        DCH0DSA = KVA_TO_PA(&U1TXREG);
+        DCH0SSIZ = size;
+        DCH0DSIZ = 1U;
+        DCH0CSIZ = 1U;
+        DCH0INTCLR = _DCH0INT_CHBCIF_MASK | _DCH0INT_CHERIF_MASK;
+        DCH0CONSET = _DCH0CON_CHEN_MASK;
+    }
+
+    return status;
+}
+
+void UART1_DMAWriteCallbackRegister( UART_CALLBACK callback, uintptr_t context )
+{
+    uart1DMACallback = callback;
+
+    uart1DMAContext = context;
+}
+
+bool UART1_DMAWriteErrorGet( void )
+{
+    return uart1DMAError;
+}
+
 UART_ERROR UART1_ErrorGet( void )
 {
     UART_ERROR errors = uart1Obj.errors;
@@ -441,9 +528,35 @@ static void __attribute__((used)) UART1_RX_InterruptHandler (void)
     }
 }
 
+/* Last byte of a DMA write has left the shift register */
+static void UART1_DMA_TX_InterruptHandler (void)
+{
+    IEC1CLR = _IEC1_U1TXIE_MASK;
+    IFS1CLR = _IFS1_U1TXIF_MASK;
+
+    /* Back to the setting of UART1_Initialize() for the interrupt driven path */
+    U1STACLR = _U1STA_UTXISEL_MASK;
+    U1STASET = _U1STA_UTXISEL1_MASK;
+
+    uart1Obj.txProcessedSize = uart1Obj.txSize;
+    uart1DMABusy = false;
+    uart1Obj.txBusyStatus = false;
+
+    if(uart1DMACallback != NULL)
+    {
+        uintptr_t dmaContext = uart1DMAContext;
+
+        uart1DMACallback(dmaContext);
+    }
+}
+
 static void __attribute__((used)) UART1_TX_InterruptHandler (void)
 {
-    if(uart1Obj.txBusyStatus == true)
+    if(uart1DMABusy == true)
+    {
+        UART1_DMA_TX_InterruptHandler();
+    }
+    else if(uart1Obj.txBusyStatus == true)
     {
         size_t txSize = uart1Obj.txSize;
         size_t txProcessedSize = uart1Obj.txProcessedSize;
@@ -517,6 +630,36 @@ void __attribute__((used)) UART_1_InterruptHandler (void)
 }
 
 
+void __attribute__((used)) DMA0_InterruptHandler (void)
+{
+    bool addressError = ((DCH0INT & _DCH0INT_CHERIF_MASK) != 0U);
+
+    DCH0CONCLR = _DCH0CON_CHEN_MASK;
+    DCH0INTCLR = _DCH0INT_CHBCIF_MASK | _DCH0INT_CHERIF_MASK;
+    IFS1CLR = _IFS1_DMA0IF_MASK;
+
+    if(addressError)
+    {
+        /* The channel stopped before the block was out, the write ends here as failed */
+        uart1DMAError = true;
+        UART1_DMA_TX_InterruptHandler();
+    }
+    else
+    {
+        /* The block is in the transmit buffer, the TX interrupt now waits for all characters to be transmitted */
+        U1STASET = _U1STA_UTXISEL0_MASK;
+        IFS1CLR = _IFS1_U1TXIF_MASK;
+
+        /* The flag is raised when transmission ends, so set it if that happened already */
+        if((U1STA & _U1STA_TRMT_MASK) != 0U)
+        {
+            IFS1SET = _IFS1_U1TXIF_MASK;
+        }
+
+        IEC1SET = _IEC1_U1TXIE_MASK;
+    }
+}
+
 bool UART1_TransmitComplete( void )
 {
     bool transmitComplete = false;
@@ -67,6 +67,10 @@
 
 void UART1_Initialize( void );
 
+/* Stops a DMA write and the UART1 interrupts, then turns UART1 off. Writes and reads in
+   progress end without their callbacks. */
+void UART1_Disable( void );
+
 bool UART1_SerialSetup( UART_SERIAL_SETUP *setup, uint32_t srcClkFreq );
 
 bool UART1_AutoBaudQuery( void );
@@ -75,6 +79,17 @@ void UART1_AutoBaudSet( bool enable );
 
 bool UART1_Write( void *buffer, const size_t size );
 
+/* Sends the buffer with DMA channel 0, without an interrupt per byte. The callback
+   registered with UART1_DMAWriteCallbackRegister() is called once the last byte has
+   left the shift register. UART1_WriteIsBusy() is true meanwhile. */
+bool UART1_DMAWrite( void *buffer, const size_t size );
+
+void UART1_DMAWriteCallbackRegister( UART_CALLBACK callback, uintptr_t context );
+
+/* True if the last DMA write was stopped by an address error instead of completing, valid
+   from its callback on. */
+bool UART1_DMAWriteErrorGet( void );
+
 bool UART1_Read( void *buffer, const size_t size );
 
 UART_ERROR UART1_ErrorGet( void );
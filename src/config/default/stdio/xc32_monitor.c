@@ -41,6 +41,7 @@
 
 extern int read(int handle, void *buffer, unsigned int len);
 extern int write(int handle, void * buffer, size_t count);
+extern size_t npz_console_write(const void *data, size_t count);
 
 
 int read(int handle, void *buffer, unsigned int len)
@@ -50,5 +51,14 @@ int read(int handle, void *buffer, unsigned int len)
 
 int write(int handle, void * buffer, size_t count)
 {
-   return -1;
+   /* stdout and stderr are buffered and sent from the UART1 interrupt, see npz_console.h */
+   if ((handle != 1) && (handle != 2))
+   {
+       return -1;
+   }
+
+   /* Report everything as written, so the library does not retry output dropped by a full buffer */
+   (void)npz_console_write(buffer, count);
+
+   return (int)count;
 }
\ No newline at end of file
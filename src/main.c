@@ -34,71 +34,105 @@ void __delay_ms(uint32_t ms)
     while((_CP0_GET_COUNT()-Start)<Duration);
 }
 
-npz_peripheral_config_s peripheral_3 = {
+/* Sensor settings, the codecs supply the bus, sequences and data format. */
+static const npz_sensor_params_s peripheral_3_params = {
     .power_mode = POWER_MODE_PERIODIC,
-    .communication_protocol = COM_SPI,
     .polling_mode = POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD,
     .power_switch_mode = POWER_SWITCH_MODE_LOGIC_OUTPUT_HIGH,
     .interrupt_pin_mode = INTERRUPT_PIN_MODE_INPUT_ACTIVE_HIGH,
     .comparison_mode = COMPARISON_MODE_INSIDE_THRESHOLD,
-    .sensor_data_type = DATA_TYPE_INT16,
-    .multi_byte_transfer_enable = 0,
-    .swap_registers = 0,
-    .spi_cfg.bytes_from_sram_num = 2,
-    .spi_cfg.bytes_from_sram = {0x20, 0x10},
-    .spi_cfg.bytes_from_sram_read_num = 1,
-    .spi_cfg.bytes_from_sram_read = {0xA8},
-    .spi_cfg.mode = SPIMOD_SPI_MODE_0,
     .polling_period = 50,
     .pre_wait_time = PRE_WAIT_TIME_EXTEND_256,
     .post_wait_time = POST_WAIT_TIME_EXTEND_256,
     .time_to_wait = 10,
-    .threshold_over = 1000,
-    .threshold_under = 64536,
+    .threshold_over_milli = 61,   // 0.061 g
+    .threshold_under_milli = -61, // -0.061 g
 };
 
-npz_peripheral_config_s peripheral_4 = {
-    .communication_protocol = COM_I2C,
+static const npz_sensor_params_s peripheral_4_params = {
     .power_mode = POWER_MODE_PERIODIC,
     .polling_mode = POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD,
     .power_switch_mode = POWER_SWITCH_MODE_LOGIC_OUTPUT_HIGH,
     .interrupt_pin_mode = INTERRUPT_PIN_MODE_INPUT_ACTIVE_HIGH,
     .comparison_mode = COMPARISON_MODE_INSIDE_THRESHOLD,
-    .sensor_data_type  = DATA_TYPE_INT16,
-    .multi_byte_transfer_enable  = MULTIBYTE_TRANSFER_ENABLE,
-    .swap_registers = ENDIAN_BIG,
     .polling_period = 0x012C, // Wakeup peripheral every 30 seconds with 10Hz clock
-    .i2c_cfg.sensor_address = 0x49,
-    .i2c_cfg.command_num = 2,
-    .i2c_cfg.bytes_from_sram = {0x01, 0x82, 0x02, 0xA0},
-    .i2c_cfg.reg_address_value = 0x00,
-    .i2c_cfg.wake_on_nak = ENABLED,
-    .i2c_cfg.num_of_retries_on_nak = 3,
+    .i2c_address = 0x49,
+    .wake_on_nak = ENABLED,
+    .num_of_retries_on_nak = 3,
     .time_to_wait = 0x31, /* 0x31 (49 in decimal):
                            * When multiplied by 4096: 49 * 4096 = 200704  clock cycles * 2.5?s (1 / 400000),
                            * which equals 501.76ms at 400kHz.
                            * When multiplied by 256: 49 * 256 = 12544  clock cycles * 2.5?s (1 / 400000),
                            * which equals 31.36ms at 400kHz.
                            */
-    .pre_wait_time = POST_WAIT_TIME_EXTEND_256,
+    .pre_wait_time = PRE_WAIT_TIME_EXTEND_256,
     .post_wait_time = POST_WAIT_TIME_EXTEND_256,
-    .threshold_over = 3200,
-    .threshold_under = 1280,
+    .threshold_over_milli = 25000,  // 25 C
+    .threshold_under_milli = 10000, // 10 C
+};
+
+/* Codec of the sensor on each peripheral, NULL if unused */
+static const npz_sensor_codec_s *const peripheral_codecs[4] = {
+    NULL,
+    NULL,
+    &npz_sensor_devkit_accel,
+    &npz_sensor_as6212,
 };
 
-npz_adc_config_channels_s npz_adc_internal_config = {
+/* Filled from the codecs and parameters above by build_peripherals() */
+static npz_peripheral_config_s peripheral_3;
+static npz_peripheral_config_s peripheral_4;
+
+/* Readings are sent over the UART every BATCH_FLUSH_WAKES wake-ups, or right away when urgent */
+#define BATCH_FLUSH_WAKES 6
+#define URGENT_TEMPERATURE_MILLI 40000 // 40 C
+
+/* Width of the temperature window suggested from the statistics, in standard deviations */
+#define SUGGESTED_WINDOW_SD 3
+
+/* Longest wait for the console buffer to drain, a full buffer takes about 45 ms at 115200 baud */
+#define CONSOLE_DRAIN_TIMEOUT_MS 1000
+
+/* With NPZ_SHELL_ENABLE, silence on the UART for this long ends the shell session and the host sleeps */
+#define SHELL_IDLE_TIMEOUT_MS 10000
+
+/* With NPZ_UPDATE_ENABLE, the host waits this long for the first or next configuration update */
+#define UPDATE_IDLE_TIMEOUT_MS 10000
+
+static char report_line[96];
+
+/* One CSV line per reading, at most 29 characters each */
+#define REPORT_SAMPLE_LINE_MAX 32
+static char report_samples[NPZ_BATCH_SIZE * REPORT_SAMPLE_LINE_MAX];
+
+/* Host state kept in the npz SRAM while the host is powered down */
+typedef struct
+{
+    uint32_t wake_count;       // Wake-ups since the retained state was last lost
+    uint16_t config_signature; // CRC of the register image last written to the device
+    npz_time_s time;           // Time since the retained state was last lost
+    npz_batch_s batch;         // Readings not reported yet
+    npz_stats_s temperature;   // Temperature statistics since the last report
+} app_retained_s;
+
+_Static_assert(sizeof(app_retained_s) <= NPZ_RETAINED_MAX_DATA, "app_retained_s does not fit NPZ_RETAINED_SIZE");
+
+static app_retained_s retained;
+static npz_image_s config_image;
+
+const npz_adc_config_channels_s npz_adc_internal_config = {
     .wakeup_enable = 0,
     .over_threshold = 0x2B,
     .under_threshold = 0x28,
 };
 
-npz_adc_config_channels_s npz_adc_external_config = {
+const npz_adc_config_channels_s npz_adc_external_config = {
     .wakeup_enable = 0,
     .over_threshold = 0x2D,
     .under_threshold = 0x26,
 };
 
-npz_device_config_s npz_configuration = {
+const npz_device_config_s npz_configuration = {
     .host_power_mode = HOST_POWER_MODE_LOGIC_OUTPUT,
     .power_switch_normal_mode_per1 = 0,
     .power_switch_normal_mode_per2 = 0,
@@ -123,114 +157,273 @@ npz_device_config_s npz_configuration = {
     .interrupt_pin_pull_up_pin4 = INT_PIN_PULL_HIGH,
     .adc_ext_sampling_enable = 0,
     .adc_clock_sel = ADC_CLK_256,
-    .adc_channels = {0, 0},
+    .adc_channels = {&npz_adc_internal_config, &npz_adc_external_config},
     .peripherals = {0, 0, &peripheral_3, &peripheral_4},
 };
 
-static void read_peripheral_acc(int peripheral_value)
+static bool build_peripherals(void)
 {
-    // Cast the acceleration value to INT16 (signed), and convert it to mg
-    float acceleration_x = (float)(int16_t)peripheral_value * 2.0f * 1000.0f / 32768.0f;
-    printf("Acceleration X axis: %.2f mg\r\n", acceleration_x);
+    return (npz_sensor_build_config(peripheral_codecs[2], &peripheral_3_params, &peripheral_3) == OK) &&
+           (npz_sensor_build_config(peripheral_codecs[3], &peripheral_4_params, &peripheral_4) == OK);
 }
 
-static void read_peripheral_temp(int peripheral_value)
+static void print_configuration_error(void)
 {
-    // Calculate the temperature in degrees Celsius
-    float temperature = peripheral_value * 0.0078125f;  // AS6212 temperature sensor resolution is 0.0078125C.
-    printf("Calculated temperature: %.3f C\r\n", temperature);
+    npz_error_s error = npz_device_get_last_error();
+
+    NPZ_TLOG("Configuration failed: cause %d, register 0x%02X, peripheral %d\r\n", error.cause, error.reg,
+             error.peripheral + 1);
 }
 
-static void npz_read_status_registers(npz_status_s *status)
+static void on_reset(npz_event_e event, int index, const npz_wake_s *wake)
 {
-    // Handle status2
-    // Read the first status register
-    if (npz_read_STA1(&status->status1) != OK)
+    if (wake->sta1.reset_source == RESETSOURCE_PWR_RESET)
     {
-        return;
+        NPZ_TLOG("Power-on reset triggered\r\n");
+    }
+    else if (wake->sta1.reset_source == RESETSOURCE_SOFT_RESET)
+    {
+        NPZ_TLOG("Soft reset triggered (via I2C command)\r\n");
+    }
+    else if (wake->sta1.reset_source == RESETSOURCE_EXT_RESET)
+    {
+        NPZ_TLOG("External reset triggered (via RST pin)\r\n");
     }
+}
+
+static void on_adc(npz_event_e event, int index, const npz_wake_s *wake)
+{
+    uint16_t millivolts;
 
-    // Handle status1
-    if (status->status1.reset_source == RESETSOURCE_NONE)
+    if (event == NPZ_EVENT_ADC_EXTERNAL)
     {
-        printf("Reset source is None\r\n");
+        NPZ_TLOG("External ADC channel (connected to ADC_IN) was triggered\r\n");
+        millivolts = npz_adc_ext_mv(wake->adc_ext);
     }
-    else if (status->status1.reset_source == RESETSOURCE_PWR_RESET)
+    else
     {
-        printf("Power-on reset triggered\r\n");
+        NPZ_TLOG("Internal ADC channel (connected to VBAT) was triggered\r\n");
+        millivolts = npz_adc_core_mv(wake->adc_core);
     }
-    else if (status->status1.reset_source == RESETSOURCE_SOFT_RESET)
+
+    NPZ_TLOG("Input voltage is %d.%03d V\r\n", millivolts / 1000, millivolts % 1000);
+}
+
+static void on_global_timeout(npz_event_e event, int index, const npz_wake_s *wake)
+{
+    NPZ_TLOG("Global Timeout triggered before any wake up source triggered\r\n");
+}
+
+/**@brief Logs a decoded value in thousandths of the unit of the codec
+ *
+ * NPZ_TLOG() takes integers only, so the value goes as whole units and thousandths with the sign in the format.
+ */
+static void log_value(int index, uint8_t n, int32_t milli)
+{
+    uint32_t magnitude = (milli < 0) ? 0U - (uint32_t)milli : (uint32_t)milli;
+
+    if (milli < 0)
     {
-        printf("Soft reset triggered (via I2C command)\r\n");
+        NPZ_TLOG("Peripheral %d value %u: -%ld.%03ld\r\n", index + 1, n, (long)(magnitude / 1000),
+                 (long)(magnitude % 1000));
     }
-    else if (status->status1.reset_source == RESETSOURCE_EXT_RESET)
+    else
     {
-        printf("External reset triggered (via RST pin)\r\n");
+        NPZ_TLOG("Peripheral %d value %u: %ld.%03ld\r\n", index + 1, n, (long)(magnitude / 1000),
+                 (long)(magnitude % 1000));
     }
+}
+
+static void on_sensor(npz_event_e event, int index, const npz_wake_s *wake)
+{
+    const npz_sensor_codec_s *codec = peripheral_codecs[index];
+    uint8_t block[NPZ_SENSOR_BLOCK_MAX];
+
+    NPZ_TLOG("External Trigger from Peripheral %d\r\n", index + 1);
+    log_value(index, 0, npz_sensor_decode(codec, wake->valp[index]));
 
-    if (status->status1.ext_adc_triggered == 1)
+    // The sensor is still powered, fetch the rest of its sample set while the host is awake
+    if (codec->block_size == 0)
     {
-        if (!npz_device_handle_adc_external())
-        {
-            return;
-        }
+        return;
     }
 
-    if (status->status1.int_adc_triggered == 1)
+    if (npz_sensor_read_block(codec, &npz_configuration, index, block, sizeof(block)) != OK)
     {
-        if (!npz_device_handle_adc_internal())
-        {
-            return;
-        }
+        NPZ_TLOG("Peripheral %d follow-up read failed\r\n", index + 1);
+        return;
     }
 
-    if (status->status1.global_timeout_triggered == 1)
+    // Value 0 above is the polled one, the sample set follows as values 1 on
+    for (uint8_t i = 0; i < codec->block_size / 2; i++)
     {
-        printf("Global Timeout triggered before any wake up source triggered\r\n");
+        log_value(index, (uint8_t)(i + 1), npz_sensor_decode(codec, npz_sensor_block_value(codec, block, i)));
     }
+}
 
-    // Read the second status register
-    if (npz_read_STA2(&status->status2) != OK)
+static void on_peripheral_timeout(npz_event_e event, int index, const npz_wake_s *wake)
+{
+    NPZ_TLOG("Peripheral %d global timeout was triggered\r\n", index + 1);
+}
+
+static bool is_urgent(const npz_history_sample_s *sample)
+{
+    return (sample->peripheral == 3) &&
+           (npz_sensor_decode(peripheral_codecs[3], sample->raw) > URGENT_TEMPERATURE_MILLI);
+}
+
+static const npz_batch_policy_s batch_policy = {
+    .flush_wakes = BATCH_FLUSH_WAKES,
+    .urgent_events = NPZ_EVENT_ADC_INTERNAL, // Battery voltage out of range
+    .is_urgent = is_urgent,
+};
+
+/**@brief Formats a raw temperature value, saturated to the range of the sensor
+ */
+static void format_temperature(int32_t raw, char *text, size_t size)
+{
+    raw = (raw < INT16_MIN) ? INT16_MIN : (raw > INT16_MAX) ? INT16_MAX : raw;
+    npz_convert_format(npz_sensor_decode(peripheral_codecs[3], (uint16_t)raw), peripheral_codecs[3]->decimals, text,
+                       size);
+}
+
+/**@brief Sends the temperature statistics of the batch, with the threshold window they suggest
+ */
+static void write_summary(const npz_stats_s *stats)
+{
+    int32_t mean = npz_stats_mean(stats);
+    int32_t margin = (int32_t)npz_stats_stddev(stats) * SUGGESTED_WINDOW_SD;
+    char min[12], max[12], average[12], sd[12], low[12], high[12];
+
+    if (stats->count == 0)
     {
         return;
     }
 
-    // Handle status2
-    // Arrays to map peripherals and switches
-    npz_psw_e switches[4] = {PSW_LP1, PSW_LP2, PSW_LP3, PSW_LP4};
-    uint8_t triggered[4] = {status->status2.per1_triggered, status->status2.per2_triggered,
-                            status->status2.per3_triggered, status->status2.per4_triggered};
-    uint8_t timeouts[4] = {status->status2.per1_global_timeout, status->status2.per2_global_timeout,
-                           status->status2.per3_global_timeout, status->status2.per4_global_timeout};
+    format_temperature(stats->min, min, sizeof(min));
+    format_temperature(stats->max, max, sizeof(max));
+    format_temperature(mean, average, sizeof(average));
+    format_temperature(margin / SUGGESTED_WINDOW_SD, sd, sizeof(sd));
+    format_temperature(mean - margin, low, sizeof(low));
+    format_temperature(mean + margin, high, sizeof(high));
 
-    // Iterate over each peripheral to check for triggers and timeouts
-    for (int i = 0; i < 4; i++)
+    int length = snprintf(report_line, sizeof(report_line), "# n=%u min=%s max=%s mean=%s sd=%s window=%s..%s %s\r\n",
+                          stats->count, min, max, average, sd, low, high, peripheral_codecs[3]->unit);
+
+    if (length > 0)
     {
-       if (triggered[i]) // Check if peripheral is triggered
-       {
-            int peripheral_value = 0;
+        npz_console_write(report_line, (size_t)length);
+    }
+}
 
-            npz_device_read_peripheral_value(switches[i], i,
-                                             &peripheral_value); // Read the peripheral value based on the switch
+/* UART1 is only powered while a batch is sent, console output buffered until then goes out first */
+static bool uart_open(void *context)
+{
+    UART1_Initialize();
+    npz_console_kick();
+    write_summary(&retained.temperature);
+    return true;
+}
 
-            if (npz_configuration.peripherals[i]->communication_protocol == COM_SPI && i == 2)
-            {
-                read_peripheral_acc(peripheral_value);
-            }
-            else if (npz_configuration.peripherals[i]->communication_protocol == COM_I2C &&
-                (npz_configuration.peripherals[i]->polling_mode == POLLING_MODE_PERIODIC_READ_COMPARE_THRESHOLD ||
-                 npz_configuration.peripherals[i]->polling_mode ==
-                     POLLING_MODE_PERIODIC_WAIT_INTERRUPT_COMPARE_THRESHOLD))
-            {
-                read_peripheral_temp(peripheral_value);
-            }
-        }
+/* The readings go out in one DMA transfer, so they cannot be dropped by the console policy */
+static bool uart_write(const npz_history_sample_s *samples, uint16_t count, void *context)
+{
+    size_t size = 0;
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        int length = snprintf(&report_samples[size], sizeof(report_samples) - size, "%lu,%d,0x%03X,%u\r\n",
+                              (unsigned long)samples[i].timestamp, samples[i].peripheral, samples[i].reason,
+                              samples[i].raw);
 
-        if (timeouts[i]) // Check if global timeout is triggered for this peripheral
+        if (length <= 0 || (size_t)length >= sizeof(report_samples) - size)
         {
-            printf("Peripheral %d global timeout was triggered\r\n", i + 1); // Log the timeout event
+            return false;
         }
+
+        size += (size_t)length;
+    }
+
+    // The summary and earlier console output go first
+    if (!npz_console_drain(CONSOLE_DRAIN_TIMEOUT_MS))
+    {
+        return false;
     }
+
+    return npz_console_send(report_samples, size, NULL, 0);
+}
+
+/* Also waits for the DMA transfer of the readings, output still pending after the timeout is dropped */
+static void uart_close(void *context)
+{
+    npz_console_drain(CONSOLE_DRAIN_TIMEOUT_MS);
+    UART1_Disable();
+}
+
+static const npz_batch_sink_s uart_sink = {
+    .open = uart_open,
+    .write = uart_write,
+    .close = uart_close,
+};
+
+/* Flush hook of the driver, sends what the console still holds before the device cuts the host power */
+static bool flush_console(uint32_t timeout)
+{
+    bool drained;
+
+    if (npz_console_free() == NPZ_CONSOLE_SIZE)
+    {
+        return true;
+    }
+
+    UART1_Initialize();
+    drained = npz_console_drain(timeout);
+    UART1_Disable();
+
+    return drained;
+}
+
+/**@brief Computes the CRC of the register writes the configuration results in, without touching the device
+ *
+ * Leaves the writes of npz_configuration alone in config_image, the base of npz_update_run().
+ */
+static uint16_t config_signature(void)
+{
+    npz_capture_begin(&config_image);
+    npz_status_e status = npz_device_configure(&npz_configuration);
+
+    if (npz_capture_end() != OK || status != OK)
+    {
+        return 0;
+    }
+
+    uint16_t crc = npz_crc16(NPZ_CRC16_INIT, config_image.reg, config_image.count);
+    crc = npz_crc16(crc, config_image.value, config_image.count);
+
+    // Updates received from the host are part of what the device holds
+    return NPZ_UPDATE_ENABLE ? npz_update_signature(crc) : crc;
+}
+
+static void print_time(const npz_time_s *time)
+{
+    if (time->error_ms == NPZ_TIME_ERROR_UNKNOWN)
+    {
+        NPZ_TLOG("Time: %lu.%03u s, error unknown\r\n", (unsigned long)time->seconds, time->millis);
+    }
+    else
+    {
+        NPZ_TLOG("Time: %lu.%03u s +/- %lu ms\r\n", (unsigned long)time->seconds, time->millis,
+                 (unsigned long)time->error_ms);
+    }
+}
+
+static void register_event_handlers(void)
+{
+    npz_event_register(NPZ_EVENT_RESET, on_reset);
+    npz_event_register(NPZ_EVENT_ADC_INTERNAL | NPZ_EVENT_ADC_EXTERNAL, on_adc);
+    npz_event_register(NPZ_EVENT_GLOBAL_TIMEOUT, on_global_timeout);
+    npz_event_register(NPZ_EVENT_PER3_TRIGGER | NPZ_EVENT_PER4_TRIGGER, on_sensor);
+    npz_event_register(NPZ_EVENT_PER_TIMEOUT_ALL, on_peripheral_timeout);
 }
 
 /**@brief Function for detecting the nPZero on the I2C bus
@@ -243,12 +436,12 @@ uint8_t npz_search(void)
 
     if ((sample_data) == 0x60)
     {
-    	printf("[--- nPZero Init OK ---]\r\n");
+    	NPZ_TLOG("[--- nPZero Init OK ---]\r\n");
     	return 1;
     }
     else
     {
-    	printf("[--- nPZero Init Not OK 0x%x---]\r\n", sample_data);
+    	NPZ_TLOG("[--- nPZero Init Not OK 0x%x---]\r\n", sample_data);
     	return 0;
     }
 }
@@ -261,33 +454,147 @@ uint8_t npz_search(void)
 
 int main ( void )
 {
+    // The core timer starts at power-up, measure the on-time of the host from here
+    uint32_t awake_start = _CP0_GET_COUNT();
+
     /* Initialize all modules */
     SYS_Initialize ( NULL );
+
+    // SYS_Initialize() starts UART1, it stays off until there is output to send, see uart_open()
+    UART1_Disable();
     
-    printf("nPZero-Gen1 PIC32MX TEST ");
+    NPZ_TLOG("nPZero-Gen1 PIC32MX TEST ");
     
         // Initialize the npz interface
     npz_hal_init();
+    npz_hal_set_flush(flush_console);
 
     __delay_ms(1);
 
-    // Read the status registers of the npz device after every reset
-    npz_status_s npz_status = { 0 };
+    // Handle the wake sources of the npz device after every reset
+    register_event_handlers();
+
+    bool built = build_peripherals();
+    uint16_t signature = built ? config_signature() : 0;
+    npz_wake_s wake;
+
+    // The device holds this configuration unless it was reset, decode its values accordingly
+    npz_device_set_modes(built ? &npz_configuration : NULL);
+    bool restored = (npz_retained_load(&retained, sizeof(retained)) == OK);
+
+    // The device slept with this configuration if it was the last one written
+    bool same_config = restored && signature != 0 && signature == retained.config_signature;
+
+    if (!restored)
+    {
+        memset(&retained, 0, sizeof(retained));
+        npz_time_reset(&retained.time);
+    }
+
+    if (npz_process_wake(&wake) != OK)
+    {
+        NPZ_TLOG("Failed to read the wake-up status\r\n");
+
+        // A reset of the device cannot be ruled out, so its configuration is written again
+        same_config = false;
+    }
+    else
+    {
+        if (restored)
+        {
+            npz_time_on_wake(&retained.time, same_config ? &npz_configuration : NULL, &wake);
+        }
+
+        print_time(&retained.time);
+        retained.wake_count++;
 
-    npz_read_status_registers(&npz_status);
+        // Collectors parse this record instead of the text output, see npz_report.h and tools/npz_reportlib.c
+        if (NPZ_REPORT_ENABLE && npz_report_send(&wake, retained.wake_count, &retained.time) != OK)
+        {
+            NPZ_TLOG("Wake report dropped\r\n");
+        }
+
+        if (wake.events & NPZ_EVENT_PER4_TRIGGER)
+        {
+            npz_stats_add(&retained.temperature, wake.value[3]);
+        }
+
+        if (npz_batch_record_wake(&retained.batch, &batch_policy, &wake, retained.time.seconds))
+        {
+            if (npz_batch_flush(&retained.batch, &uart_sink) == OK)
+            {
+                npz_stats_reset(&retained.temperature);
+            }
+            else
+            {
+                NPZ_TLOG("Report postponed\r\n");
+            }
+        }
+    }
 
     npz_search();
 
-    // Send the configuration to the device
-    npz_device_configure(&npz_configuration);
+    // Send the configuration to the device, unless it still holds this exact configuration
+    if (!built)
+    {
+        NPZ_TLOG("Sensor configuration failed\r\n");
+    }
+    else if (same_config && wake.sta1.reset_source == RESETSOURCE_NONE)
+    {
+        NPZ_TLOG("Configuration unchanged, %lu wake-ups\r\n", (unsigned long)retained.wake_count);
+    }
+    else if ((NPZ_UPDATE_ENABLE ? npz_update_configure(&npz_configuration) : npz_device_configure(&npz_configuration)) !=
+             OK)
+    {
+        print_configuration_error();
+        retained.config_signature = 0;
+    }
+    else
+    {
+        retained.config_signature = signature;
+    }
 
     // Logs and reads all configuration registers for debugging purposes
     npz_log_configurations(&npz_configuration);
 
+    // Thresholds can be tuned from a terminal before the host sleeps, see npz_shell.h
+    if (NPZ_SHELL_ENABLE)
+    {
+        UART1_Initialize();
+        npz_console_kick();
+        npz_shell_run(&npz_configuration, SHELL_IDLE_TIMEOUT_MS);
+        uart_close(NULL);
+    }
+
+    // Configuration updates pushed from the host, see npz_update.h and tools/npz_update.c
+    if (NPZ_UPDATE_ENABLE && signature != 0)
+    {
+        bool changed = false;
+
+        UART1_Initialize();
+        npz_console_kick();
+        npz_update_run(&npz_configuration, &config_image, UPDATE_IDLE_TIMEOUT_MS, &changed);
+        uart_close(NULL);
+
+        // The device now holds the stored updates, wake-ups with this signature need no configuration
+        if (changed)
+        {
+            retained.config_signature = config_signature();
+        }
+    }
+
     // Add a delay in main, to give the user time to flash the MCU before it enters sleep
     // This delay should be removed in production code
     __delay_ms(1);
 
+    // Keep the host state in the npz device while the host is off
+    npz_time_add_awake(&retained.time, (_CP0_GET_COUNT() - awake_start) / TICK_PER_MS);
+
+    if (npz_retained_save(&retained, sizeof(retained)) != OK)
+    {
+        NPZ_TLOG("Failed to save the retained state\r\n");
+    }
+
     // At the end of your operations, put the device into sleep mode
     npz_device_go_to_sleep();
 
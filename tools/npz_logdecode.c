@@ -0,0 +1,483 @@
+/**
+ * @file npz_logdecode.c
+ * @brief Turns the binary output of npz_log_configurations() back into the register tables.
+ *
+ * Reads the UART capture from a file or standard input. COBS frames holding a log record (see npz_logs.h) are printed
+ * as table lines, wake reports (see npz_report.h) are left out, everything else is copied through as text. Tokens sent
+ * by NPZ_TLOG() (see npz_token.h) are expanded with the format strings of the .npz_tokens section of the firmware ELF
+ * file given with -e.
+ *
+ * Build and use on Linux:
+ *     gcc -O2 -o npz_logdecode tools/npz_logdecode.c
+ *     stty -F /dev/ttyUSB0 115200 raw && ./npz_logdecode -e nPZero_xc32.X.production.elf /dev/ttyUSB0
+ *
+ * Pass -t to prefix each table line with the device timestamp in milliseconds.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <elf.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../nPZero_Driver/Inc/npz_registers.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+#define RECORD_TABLE    0x01
+#define RECORD_REGISTER 0x02
+#define RECORD_END      0x03
+#define RECORD_TOKEN    0x04
+#define RECORD_REPORT   0x05
+
+#define RECORD_SIZE 5
+
+/** Longest token record: type, token and eight 5-byte varints. */
+#define TOKEN_RECORD_MAX (3 + 8 * 5)
+
+#define TOKEN_SECTION ".npz_tokens"
+
+/** Longest chunk between two zero bytes kept, longer text is flushed in pieces. */
+#define CHUNK_MAX 256
+
+#define RULE "----------------------------------------------"
+
+#define NAME(reg) [REG_##reg] = #reg
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+static const char *const m_register_names[256] = {
+    NAME(SLEEP_RST), NAME(ID), NAME(STA1), NAME(STA2), NAME(PSWCTL), NAME(SYSCFG1), NAME(SYSCFG2), NAME(SYSCFG3),
+    NAME(TOUT_L), NAME(TOUT_H), NAME(INTCFG), NAME(CFGP1), NAME(MODP1), NAME(PERP1_L), NAME(PERP1_H), NAME(NCMDP1),
+    NAME(ADDRP1), NAME(RREGP1), NAME(THROVP1_L), NAME(THROVP1_H), NAME(THRUNP1_L), NAME(THRUNP1_H), NAME(TWTP1),
+    NAME(TCFGP1), NAME(CFGP2), NAME(MODP2), NAME(PERP2_L), NAME(PERP2_H), NAME(NCMDP2), NAME(ADDRP2), NAME(RREGP2),
+    NAME(THROVP2_L), NAME(THROVP2_H), NAME(THRUNP2_L), NAME(THRUNP2_H), NAME(TWTP2), NAME(TCFGP2), NAME(CFGP3),
+    NAME(MODP3), NAME(PERP3_L), NAME(PERP3_H), NAME(NCMDP3), NAME(ADDRP3), NAME(RREGP3), NAME(THROVP3_L),
+    NAME(THROVP3_H), NAME(THRUNP3_L), NAME(THRUNP3_H), NAME(TWTP3), NAME(TCFGP3), NAME(CFGP4), NAME(MODP4),
+    NAME(PERP4_L), NAME(PERP4_H), NAME(NCMDP4), NAME(ADDRP4), NAME(RREGP4), NAME(THROVP4_L), NAME(THROVP4_H),
+    NAME(THRUNP4_L), NAME(THRUNP4_H), NAME(TWTP4), NAME(TCFGP4), NAME(THROVA1), NAME(THRUNA1), NAME(THROVA2),
+    NAME(THRUNA2), NAME(VALP1_L), NAME(VALP1_H), NAME(VALP2_L), NAME(VALP2_H), NAME(VALP3_L), NAME(VALP3_H),
+    NAME(VALP4_L), NAME(VALP4_H), NAME(ADC_CORE), NAME(ADC_EXT),
+};
+
+/** Title line of each table, indexed by the address field of a RECORD_TABLE. */
+static const char *const m_table_titles[] = {
+    "          Read global registers               ",
+    "          Read status registers               ",
+    "         Read peripheral 1 registers       ",
+    "         Read peripheral 2 registers       ",
+    "         Read peripheral 3 registers       ",
+    "         Read peripheral 4 registers       ",
+    "          Read internal adc registers         ",
+    "          Read external adc registers          ",
+};
+
+static bool m_timestamps = false;
+
+static char *m_tokens = NULL; /**< Content of the .npz_tokens section, NULL without -e. */
+static size_t m_tokens_size = 0;
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief Decodes a COBS frame without its delimiter.
+ *
+ * @return Decoded length, or -1 if the frame is malformed or does not fit.
+ */
+static int cobs_decode(const uint8_t *frame, size_t length, uint8_t *data, size_t size)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < length)
+    {
+        uint8_t code = frame[in++];
+
+        if (code == 0 || in + code - 1 > length)
+        {
+            return -1;
+        }
+
+        for (uint8_t i = 1; i < code; i++)
+        {
+            if (out >= size)
+            {
+                return -1;
+            }
+
+            data[out++] = frame[in++];
+        }
+
+        // Every block but the last and the full ones stood for a zero
+        if (code != 0xFF && in < length)
+        {
+            if (out >= size)
+            {
+                return -1;
+            }
+
+            data[out++] = 0;
+        }
+    }
+
+    return (int)out;
+}
+
+/**
+ * @brief Loads the .npz_tokens section of an ELF file, 32 or 64 bit, little endian.
+ */
+static bool load_tokens(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    unsigned char *image = NULL;
+    long size;
+    bool found = false;
+
+    if (file == NULL)
+    {
+        perror(path);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size < (long)sizeof(Elf32_Ehdr) || (image = malloc((size_t)size)) == NULL ||
+        fread(image, 1, (size_t)size, file) != (size_t)size || memcmp(image, ELFMAG, SELFMAG) != 0 ||
+        image[EI_DATA] != ELFDATA2LSB)
+    {
+        fprintf(stderr, "%s: not a little endian ELF file\n", path);
+        free(image);
+        fclose(file);
+        return false;
+    }
+
+    fclose(file);
+
+    // The two classes only differ in field widths, copy out the few fields needed
+    for (unsigned i = 0;; i++)
+    {
+        uint64_t section_offset, count, strings_index, name, offset, length;
+
+        if (image[EI_CLASS] == ELFCLASS64)
+        {
+            const Elf64_Ehdr *header = (const Elf64_Ehdr *)image;
+            section_offset = header->e_shoff;
+            count = header->e_shnum;
+            strings_index = header->e_shstrndx;
+        }
+        else
+        {
+            const Elf32_Ehdr *header = (const Elf32_Ehdr *)image;
+            section_offset = header->e_shoff;
+            count = header->e_shnum;
+            strings_index = header->e_shstrndx;
+        }
+
+        if (i >= count)
+        {
+            break;
+        }
+
+        uint64_t entry = (image[EI_CLASS] == ELFCLASS64) ? sizeof(Elf64_Shdr) : sizeof(Elf32_Shdr);
+        const unsigned char *section = image + section_offset + i * entry;
+        const unsigned char *strings = image + section_offset + strings_index * entry;
+        uint64_t strings_offset;
+
+        if (section_offset + count * entry > (uint64_t)size)
+        {
+            break;
+        }
+
+        if (image[EI_CLASS] == ELFCLASS64)
+        {
+            name = ((const Elf64_Shdr *)section)->sh_name;
+            offset = ((const Elf64_Shdr *)section)->sh_offset;
+            length = ((const Elf64_Shdr *)section)->sh_size;
+            strings_offset = ((const Elf64_Shdr *)strings)->sh_offset;
+        }
+        else
+        {
+            name = ((const Elf32_Shdr *)section)->sh_name;
+            offset = ((const Elf32_Shdr *)section)->sh_offset;
+            length = ((const Elf32_Shdr *)section)->sh_size;
+            strings_offset = ((const Elf32_Shdr *)strings)->sh_offset;
+        }
+
+        if (strings_offset + name + sizeof(TOKEN_SECTION) > (uint64_t)size || offset + length > (uint64_t)size ||
+            strcmp((const char *)image + strings_offset + name, TOKEN_SECTION) != 0)
+        {
+            continue;
+        }
+
+        // Keep a terminator after the last string
+        m_tokens = calloc(1, (size_t)length + 1);
+        memcpy(m_tokens, image + offset, (size_t)length);
+        m_tokens_size = (size_t)length;
+        found = true;
+        break;
+    }
+
+    free(image);
+
+    if (!found)
+    {
+        fprintf(stderr, "%s: no " TOKEN_SECTION " section\n", path);
+    }
+
+    return found;
+}
+
+/**
+ * @brief Prints a printf format with arguments sent as 32-bit values.
+ */
+static void print_format(const char *format, const uint32_t *args, size_t count)
+{
+    size_t used = 0;
+
+    while (*format != '\0')
+    {
+        char spec[32];
+        size_t length = 0;
+        char conversion;
+
+        if (*format != '%')
+        {
+            putchar(*format++);
+            continue;
+        }
+
+        // Flags, width and precision are kept, length modifiers dropped: every argument came as 32 bits
+        spec[length++] = *format++;
+
+        while (*format != '\0' && strchr("-+ #0123456789.", *format) != NULL && length < sizeof(spec) - 2)
+        {
+            spec[length++] = *format++;
+        }
+
+        while (*format != '\0' && strchr("hlzjt", *format) != NULL)
+        {
+            format++;
+        }
+
+        conversion = *format;
+
+        if (conversion == '\0')
+        {
+            break;
+        }
+
+        format++;
+        spec[length++] = conversion;
+        spec[length] = '\0';
+
+        if (conversion == '%')
+        {
+            putchar('%');
+        }
+        else if (used >= count)
+        {
+            printf("<missing>");
+        }
+        else if (conversion == 'd' || conversion == 'i' || conversion == 'c')
+        {
+            printf(spec, (int)(int32_t)args[used++]);
+        }
+        else if (strchr("uxXo", conversion) != NULL)
+        {
+            printf(spec, (unsigned)args[used++]);
+        }
+        else
+        {
+            printf("<%%%c 0x%08X>", conversion, (unsigned)args[used++]);
+        }
+    }
+}
+
+static void print_token(const uint8_t *record, size_t length)
+{
+    unsigned token = record[1] | (record[2] << 8);
+    uint32_t args[8];
+    size_t count = 0;
+    unsigned shift = 0;
+    uint32_t value = 0;
+
+    for (size_t i = 3; i < length && count < 8; i++)
+    {
+        value |= (uint32_t)(record[i] & 0x7F) << shift;
+        shift += 7;
+
+        if (!(record[i] & 0x80))
+        {
+            args[count++] = value;
+            value = 0;
+            shift = 0;
+        }
+    }
+
+    if (m_tokens != NULL && token < m_tokens_size)
+    {
+        print_format(m_tokens + token, args, count);
+        return;
+    }
+
+    printf("<token 0x%04X", token);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        printf(" %u", (unsigned)args[i]);
+    }
+
+    printf(">\n");
+}
+
+static void print_record(const uint8_t *record)
+{
+    uint8_t type = record[0];
+    uint8_t address = record[1];
+    uint8_t value = record[2];
+    unsigned timestamp = record[3] | (record[4] << 8);
+    char binary[9];
+
+    if (m_timestamps)
+    {
+        printf("%5u ", timestamp);
+    }
+
+    if (type == RECORD_TABLE)
+    {
+        const char *title = (address < sizeof(m_table_titles) / sizeof(m_table_titles[0])) ?
+            m_table_titles[address] : "          Unknown table";
+
+        printf(RULE "\n%s\n" RULE "\n[  ADDR |    REGISTER    |     BIN    | HEX  ]\n" RULE "\n", title);
+    }
+    else if (type == RECORD_REGISTER)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            binary[i] = (value & (0x80 >> i)) ? '1' : '0';
+        }
+
+        binary[8] = '\0';
+
+        printf("[  %02X   | %-14s | %-10s | 0x%02X ] \n", address,
+               m_register_names[address] ? m_register_names[address] : "?", binary, value);
+    }
+    else
+    {
+        printf(RULE "\n");
+    }
+}
+
+/**
+ * @brief Prints a chunk found between two zero bytes, as a record if it is one.
+ */
+static void handle_chunk(const uint8_t *chunk, size_t length)
+{
+    uint8_t record[TOKEN_RECORD_MAX + 1];
+    int decoded = cobs_decode(chunk, length, record, sizeof(record));
+
+    if (decoded == RECORD_SIZE && record[0] >= RECORD_TABLE && record[0] <= RECORD_END)
+    {
+        print_record(record);
+        return;
+    }
+
+    if (decoded >= 3 && decoded <= TOKEN_RECORD_MAX && record[0] == RECORD_TOKEN)
+    {
+        print_token(record, (size_t)decoded);
+        return;
+    }
+
+    // Wake reports are read by tools/npz_reportdump.c
+    if (decoded > 0 && record[0] == RECORD_REPORT)
+    {
+        return;
+    }
+
+    fwrite(chunk, 1, length, stdout);
+}
+
+/*****************************************************************************
+ * Main
+ *****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    FILE *input = stdin;
+    uint8_t chunk[CHUNK_MAX];
+    size_t length = 0;
+    int c;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0)
+        {
+            m_timestamps = true;
+        }
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+        {
+            if (!load_tokens(argv[++i]))
+            {
+                return 1;
+            }
+        }
+        else if (path == NULL && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-t] [-e firmware.elf] [capture]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (path != NULL && (input = fopen(path, "rb")) == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    while ((c = fgetc(input)) != EOF)
+    {
+        if (c == 0)
+        {
+            handle_chunk(chunk, length);
+            length = 0;
+            fflush(stdout);
+            continue;
+        }
+
+        // Text runs longer than any frame cannot be a record
+        if (length == sizeof(chunk))
+        {
+            fwrite(chunk, 1, length, stdout);
+            length = 0;
+        }
+
+        chunk[length++] = (uint8_t)c;
+    }
+
+    fwrite(chunk, 1, length, stdout);
+
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file npz_reportdump.c
+ * @brief Prints the wake reports of a firmware built with NPZ_REPORT_ENABLE as CSV, one line per wake-up.
+ *
+ * Reads the UART capture from a file or standard input, everything but the reports is skipped. The columns are
+ * wake,seconds,version,reset,events,valp1,valp2,valp3,valp4,adc_core,adc_ext, the events in hexadecimal. Reports
+ * that fail their CRC are counted on standard error.
+ *
+ * Build and use on Linux:
+ *     gcc -O2 -o npz_reportdump tools/npz_reportdump.c tools/npz_reportlib.c
+ *     stty -F /dev/ttyUSB0 115200 raw && ./npz_reportdump /dev/ttyUSB0
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <stdio.h>
+
+#include "npz_reportlib.h"
+
+/*****************************************************************************
+ * Main
+ *****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static npz_report_reader_s reader;
+    FILE *input = stdin;
+    npz_report_s report;
+    unsigned long corrupt = 0;
+    int c;
+
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-'))
+    {
+        fprintf(stderr, "usage: %s [capture]\n", argv[0]);
+        return 2;
+    }
+
+    if (argc == 2 && (input = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    npz_report_reader_init(&reader);
+    printf("wake,seconds,version,reset,events,valp1,valp2,valp3,valp4,adc_core,adc_ext\n");
+
+    while ((c = fgetc(input)) != EOF)
+    {
+        switch (npz_report_reader_push(&reader, (uint8_t)c, &report))
+        {
+        case NPZ_REPORT_VALID:
+            printf("%lu,%lu.%03u,%u,%u,0x%03X,%u,%u,%u,%u,%u,%u\n", (unsigned long)report.wake_count,
+                   (unsigned long)report.seconds, report.millis, report.version, report.reset_source, report.events,
+                   report.valp[0], report.valp[1], report.valp[2], report.valp[3], report.adc_core, report.adc_ext);
+            fflush(stdout);
+            break;
+
+        case NPZ_REPORT_CORRUPT:
+            fprintf(stderr, "corrupt report %lu\n", ++corrupt);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+
+    return 0;
+}
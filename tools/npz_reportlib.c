@@ -0,0 +1,164 @@
+/**
+ * @file npz_reportlib.c
+ * @brief Implementation of the wake report parser.
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <string.h>
+
+#include "npz_reportlib.h"
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief CRC-16/CCITT-FALSE, as npz_crc16() of the firmware.
+ */
+static uint16_t crc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)(data[i] << 8);
+
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Decodes a COBS frame without its delimiter.
+ *
+ * @return Decoded length, or -1 if the frame is malformed or does not fit.
+ */
+static int cobs_decode(const uint8_t *frame, size_t length, uint8_t *data, size_t size)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < length)
+    {
+        uint8_t code = frame[in++];
+
+        if (code == 0 || in + code - 1 > length)
+        {
+            return -1;
+        }
+
+        for (uint8_t i = 1; i < code; i++)
+        {
+            if (out >= size)
+            {
+                return -1;
+            }
+
+            data[out++] = frame[in++];
+        }
+
+        // Every block but the last and the full ones stood for a zero
+        if (code != 0xFF && in < length)
+        {
+            if (out >= size)
+            {
+                return -1;
+            }
+
+            data[out++] = 0;
+        }
+    }
+
+    return (int)out;
+}
+
+static uint16_t get_u16(const uint8_t *in)
+{
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *in)
+{
+    return get_u16(in) | ((uint32_t)get_u16(in + 2) << 16);
+}
+
+/*****************************************************************************
+ * Public Methods
+ *****************************************************************************/
+
+npz_report_result_e npz_report_parse(const uint8_t *frame, size_t length, npz_report_s *report)
+{
+    uint8_t payload[NPZ_REPORT_FRAME_MAX];
+    int decoded = cobs_decode(frame, length, payload, sizeof(payload));
+
+    if (decoded < 1 || payload[0] != NPZ_REPORT_RECORD)
+    {
+        return NPZ_REPORT_NONE;
+    }
+
+    // Version 0 does not exist, such a frame is damaged
+    if (decoded < NPZ_REPORT_MIN_SIZE || payload[1] == 0 ||
+        crc16(payload, (size_t)decoded - 2) != get_u16(&payload[decoded - 2]))
+    {
+        return NPZ_REPORT_CORRUPT;
+    }
+
+    report->version = payload[1];
+    report->reset_source = payload[2];
+    report->events = get_u16(&payload[3]);
+
+    for (int i = 0; i < 4; i++)
+    {
+        report->valp[i] = get_u16(&payload[5 + 2 * i]);
+    }
+
+    report->adc_core = payload[13];
+    report->adc_ext = payload[14];
+    report->wake_count = get_u32(&payload[15]);
+    report->seconds = get_u32(&payload[19]);
+    report->millis = get_u16(&payload[23]);
+
+    return NPZ_REPORT_VALID;
+}
+
+void npz_report_reader_init(npz_report_reader_s *reader)
+{
+    memset(reader, 0, sizeof(*reader));
+}
+
+npz_report_result_e npz_report_reader_push(npz_report_reader_s *reader, uint8_t byte, npz_report_s *report)
+{
+    npz_report_result_e result = NPZ_REPORT_NONE;
+
+    if (byte != 0)
+    {
+        if (reader->length < sizeof(reader->frame))
+        {
+            reader->frame[reader->length++] = byte;
+        }
+        else
+        {
+            reader->overflow = 1;
+        }
+
+        return NPZ_REPORT_NONE;
+    }
+
+    // Two zero bytes in a row, as between consecutive records, delimit nothing
+    if (reader->length > 0 && !reader->overflow)
+    {
+        result = npz_report_parse(reader->frame, reader->length, report);
+    }
+
+    reader->length = 0;
+    reader->overflow = 0;
+
+    return result;
+}
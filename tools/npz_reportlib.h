@@ -0,0 +1,77 @@
+/**
+ * @file npz_reportlib.h
+ * @brief Parser for the binary wake reports of npz_report.h, for collectors on a Linux host.
+ *
+ * Feed the raw UART bytes to npz_report_reader_push() one at a time. Text, log records and tokens in between are
+ * skipped, each report frame is checked against its CRC and decoded. Reports of a later layout version parse as
+ * well, with the fields this version knows.
+ *
+ * Build it into a collector with its header, e.g.
+ *     gcc -O2 -c tools/npz_reportlib.c
+ */
+
+#ifndef NPZ_REPORTLIB_H
+#define NPZ_REPORTLIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Record type of a report, NPZ_REPORT_RECORD of the firmware. */
+#define NPZ_REPORT_RECORD 0x05
+
+/** Bytes of a version 1 report, the smallest accepted. */
+#define NPZ_REPORT_MIN_SIZE 27
+
+/** Longest COBS frame kept by the reader, longer runs are skipped. */
+#define NPZ_REPORT_FRAME_MAX 256
+
+/** Fields of a report. */
+typedef struct
+{
+    uint8_t version;      /**< Layout version of the firmware that sent it. */
+    uint8_t reset_source; /**< Reset source of STA1, 0 none, 1 power-on, 2 soft, 3 external. */
+    uint16_t events;      /**< Wake flags, npz_event_e of the firmware. */
+    uint16_t valp[4];     /**< Value registers of peripherals 1 to 4. */
+    uint8_t adc_core;     /**< ADC_CORE code (VBAT). */
+    uint8_t adc_ext;      /**< ADC_EXT code (ADC_IN). */
+    uint32_t wake_count;  /**< Wake-up counter. */
+    uint32_t seconds;     /**< Time of the wake-up, whole seconds. */
+    uint16_t millis;      /**< Time of the wake-up, milliseconds on top of seconds. */
+} npz_report_s;
+
+/** Outcome of a frame. */
+typedef enum
+{
+    NPZ_REPORT_NONE,    /**< Not a report: text, another record, or no frame ended. */
+    NPZ_REPORT_VALID,   /**< A report was decoded. */
+    NPZ_REPORT_CORRUPT, /**< A report whose CRC does not match or that is too short. */
+} npz_report_result_e;
+
+/** Stream state, zero it or call npz_report_reader_init() before the first byte. */
+typedef struct
+{
+    uint8_t frame[NPZ_REPORT_FRAME_MAX];
+    size_t length;
+    int overflow; /**< The bytes since the last zero did not fit, they are not a report. */
+} npz_report_reader_s;
+
+/**
+ * @brief Decodes one COBS frame, given without its zero delimiters.
+ *
+ * @return NPZ_REPORT_VALID with *report filled, NPZ_REPORT_CORRUPT, or NPZ_REPORT_NONE if it is not a report.
+ */
+npz_report_result_e npz_report_parse(const uint8_t *frame, size_t length, npz_report_s *report);
+
+/**
+ * @brief Empties a reader.
+ */
+void npz_report_reader_init(npz_report_reader_s *reader);
+
+/**
+ * @brief Takes the next byte of the stream.
+ *
+ * @return The outcome of the frame the byte ended, NPZ_REPORT_NONE while inside a frame.
+ */
+npz_report_result_e npz_report_reader_push(npz_report_reader_s *reader, uint8_t byte, npz_report_s *report);
+
+#endif /* NPZ_REPORTLIB_H */
@@ -0,0 +1,274 @@
+/**
+ * @file npz_update.c
+ * @brief Builds a configuration update frame for a firmware built with NPZ_UPDATE_ENABLE, see npz_update.h.
+ *
+ * Each argument is one record, the first register and its values in hexadecimal, e.g. 3e=10,00 writes THROVP4_L and
+ * THROVP4_H. Without -f the records are added to the ones the device already stores, with -f they replace them.
+ *
+ * The frame goes to standard output, or with -d to the UART of the board, then the answer of the firmware is
+ * printed. Send the next frame only once the previous one is answered: the device erases flash before answering
+ * and loses what arrives meanwhile.
+ *
+ * Build and use on Linux:
+ *     gcc -O2 -o npz_update tools/npz_update.c
+ *     stty -F /dev/ttyUSB0 115200 raw && ./npz_update -d /dev/ttyUSB0 3e=10,00 40=08,00
+ */
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include "../nPZero_Driver/Inc/npz_registers.h"
+
+/*****************************************************************************
+ * Defines
+ *****************************************************************************/
+
+/* Same values as npz_update.h, which depends on the firmware headers */
+#define UPDATE_FULL       0x01
+#define UPDATE_DELTA      0x02
+#define UPDATE_RECORD_MAX 64
+
+/** Largest payload: a flash page of records, the kind and the CRC. */
+#define PAYLOAD_MAX (1024 + 3)
+
+#define ANSWER_TIMEOUT_S 5
+
+/*****************************************************************************
+ * Data
+ *****************************************************************************/
+
+static const char *const m_errors[] = {
+    "ok", "malformed frame", "register not part of the configuration", "CRC mismatch", "flash page full, send -f",
+    "register write failed", "flash programming failed",
+};
+
+/*****************************************************************************
+ * Private Methods
+ *****************************************************************************/
+
+/**
+ * @brief CRC-16/CCITT-FALSE, as npz_crc16().
+ */
+static uint16_t crc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)(data[i] << 8);
+
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Encodes a COBS frame, as npz_cobs_encode().
+ */
+static size_t cobs_encode(const uint8_t *data, size_t length, uint8_t *encoded)
+{
+    size_t code_index = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] != 0)
+        {
+            encoded[out++] = data[i];
+            code++;
+        }
+
+        if (data[i] == 0 || code == 0xFF)
+        {
+            encoded[code_index] = code;
+            code_index = out++;
+            code = 1;
+        }
+    }
+
+    encoded[code_index] = code;
+
+    return out;
+}
+
+/**
+ * @brief Appends the record of one argument, reg=value[,value...].
+ *
+ * @return False if the argument is malformed or the payload is full.
+ */
+static bool parse_record(const char *text, uint8_t *payload, size_t *length)
+{
+    size_t start = *length;
+    char *end;
+    unsigned long reg = strtoul(text, &end, 16);
+    unsigned count = 0;
+
+    if (end == text || *end != '=' || reg > REG_SRAM_END || start + 2 > PAYLOAD_MAX)
+    {
+        return false;
+    }
+
+    payload[start] = (uint8_t)reg;
+    *length = start + 2;
+
+    do
+    {
+        const char *value = end + 1;
+        unsigned long number = strtoul(value, &end, 16);
+
+        if (end == value || number > 0xFF || reg + count > REG_SRAM_END || count == UPDATE_RECORD_MAX ||
+            *length >= PAYLOAD_MAX)
+        {
+            return false;
+        }
+
+        payload[(*length)++] = (uint8_t)number;
+        count++;
+    } while (*end == ',');
+
+    payload[start + 1] = (uint8_t)count;
+
+    return *end == '\0';
+}
+
+/**
+ * @brief Prints the lines the firmware sends until its answer to the frame.
+ *
+ * @return 0 on "OK", 1 otherwise.
+ */
+static int read_answer(int fd)
+{
+    char line[128];
+    size_t length = 0;
+    char c;
+
+    for (;;)
+    {
+        fd_set set;
+        struct timeval timeout = {ANSWER_TIMEOUT_S, 0};
+
+        FD_ZERO(&set);
+        FD_SET(fd, &set);
+
+        if (select(fd + 1, &set, NULL, NULL, &timeout) <= 0 || read(fd, &c, 1) != 1)
+        {
+            fprintf(stderr, "no answer\n");
+            return 1;
+        }
+
+        if (c != '\n')
+        {
+            if (c != '\r' && length < sizeof(line) - 1)
+            {
+                line[length++] = c;
+            }
+
+            continue;
+        }
+
+        line[length] = '\0';
+        length = 0;
+
+        // Log output of the firmware may come first
+        if (strcmp(line, "OK") == 0)
+        {
+            printf("OK\n");
+            return 0;
+        }
+
+        if (strncmp(line, "ERR ", 4) == 0)
+        {
+            int code = atoi(&line[4]);
+
+            printf("%s: %s\n", line, (code > 0 && code < (int)(sizeof(m_errors) / sizeof(m_errors[0]))) ?
+                                         m_errors[code] : "unknown error");
+            return 1;
+        }
+
+        printf("%s\n", line);
+    }
+}
+
+/*****************************************************************************
+ * Main
+ *****************************************************************************/
+
+int main(int argc, char **argv)
+{
+    static uint8_t payload[PAYLOAD_MAX + 2];
+    static uint8_t frame[PAYLOAD_MAX + PAYLOAD_MAX / 254 + 4];
+    const char *device = NULL;
+    size_t length = 1;
+    size_t size;
+    uint16_t crc;
+    int fd = STDOUT_FILENO;
+
+    payload[0] = UPDATE_DELTA;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0)
+        {
+            payload[0] = UPDATE_FULL;
+        }
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            device = argv[++i];
+        }
+        else if (argv[i][0] == '-' || !parse_record(argv[i], payload, &length))
+        {
+            fprintf(stderr, "usage: %s [-f] [-d tty] reg=value[,value...] ...\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // A FULL update without records goes back to the configuration of the firmware
+    if (length == 1 && payload[0] == UPDATE_DELTA)
+    {
+        fprintf(stderr, "nothing to send\n");
+        return 2;
+    }
+
+    crc = crc16(payload, length);
+    payload[length++] = (uint8_t)crc;
+    payload[length++] = (uint8_t)(crc >> 8);
+
+    // A leading delimiter ends whatever the receiver made of earlier bytes
+    frame[0] = 0;
+    size = 1 + cobs_encode(payload, length, &frame[1]);
+    frame[size++] = 0;
+
+    if (device != NULL && (fd = open(device, O_RDWR | O_NOCTTY)) < 0)
+    {
+        perror(device);
+        return 1;
+    }
+
+    if (write(fd, frame, size) != (ssize_t)size)
+    {
+        perror("write");
+        return 1;
+    }
+
+    if (device == NULL)
+    {
+        return 0;
+    }
+
+    return read_answer(fd);
+}